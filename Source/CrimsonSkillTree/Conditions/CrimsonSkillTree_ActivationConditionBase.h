@@ -64,6 +64,8 @@ public:
 
 	/**
 	 * @brief The primary function to check if this condition is currently met.
+	 * @details May be called on the template asset's condition object, which every actor shares. Derive the result
+	 * from OwningNode and its manager, not from state cached on this object by BeginMonitoring.
 	 * @param OwningNode The node that this condition belongs to.
 	 * @return True if the condition is met, false otherwise.
 	 */
@@ -44,13 +44,15 @@ public:
 	// ~UCrimsonSkillTree_ActivationConditionBase Interface
 	// =============================================================================================================
 	/**
-	 * @brief Binds to the required attribute's change delegate to monitor for changes.
+	 * @brief Registers with the owning manager's FCrimsonSkillTree_AttributeWatcher, which shares one ASC subscription
+	 * per attribute and calls OnWatchedThresholdCrossed when RequiredValue is crossed. Binds its own delegate only
+	 * when there is no owning manager.
 	 * @param OwningNode The node that owns this condition instance.
 	 */
 	virtual void BeginMonitoring_Implementation(UCrimsonSkillTree_Node* OwningNode) override;
 
 	/**
-	 * @brief Unbinds from the attribute's change delegate.
+	 * @brief Unregisters from the attribute watcher, or unbinds its own delegate.
 	 */
 	virtual void EndMonitoring_Implementation() override;
 
@@ -77,6 +79,17 @@ public:
 	 */
 	virtual FText GetTooltipDescription_Implementation() const override;
 
+	/**
+	 * @brief Called by FCrimsonSkillTree_AttributeWatcher when the attribute moved across RequiredValue. Re-evaluates the met state.
+	 */
+	void OnWatchedThresholdCrossed();
+
+	// ~Accessors
+	// =============================================================================================================
+	const FGameplayAttribute& GetRequiredAttribute() const { return RequiredAttribute; }
+	float GetRequiredValue() const { return RequiredValue; }
+	ECrimsonAttributeComparisonType GetComparisonType() const { return ComparisonType; }
+
 #if WITH_EDITOR
 	// ~Editor-Only
 	// =============================================================================================================
@@ -87,20 +100,23 @@ public:
 	virtual FText GetEditorDescription_Implementation() const override;
 #endif
 
-public:
+protected:
 	/****************************************************************************************************************
 	* Properties                                                           *
 	****************************************************************************************************************/
+	// Authoring data, read-only at runtime: the attribute watcher keeps its watchers sorted by RequiredValue and the
+	// shared definition compiles all three into the node's condition program when the asset is loaded.
+
 	/** @brief The Gameplay Attribute that this condition monitors. */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Condition Properties")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Condition Properties", meta = (AllowPrivateAccess = "true"))
 	FGameplayAttribute RequiredAttribute;
 
 	/** @brief The threshold value the attribute must meet. */
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Condition Properties", meta = (UIMin = "0.0"))
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Condition Properties", meta = (UIMin = "0.0", AllowPrivateAccess = "true"))
 	float RequiredValue;
 
 	/** @brief Defines how the attribute's current value is compared against RequiredValue. */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Condition Properties")
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Condition Properties", meta = (AllowPrivateAccess = "true"))
 	ECrimsonAttributeComparisonType ComparisonType;
 
 protected:
@@ -129,6 +145,6 @@ private:
 	UPROPERTY(Transient)
 	TWeakObjectPtr<UAbilitySystemComponent> CachedAbilitySystemComponent;
 
-	/** @brief Handle for the delegate bound to attribute value changes. */
+	/** @brief Handle for the delegate bound to attribute value changes. Only used when there is no attribute watcher. */
 	FDelegateHandle AttributeChangeDelegateHandle;
 };
@@ -92,6 +92,8 @@ protected:
 	****************************************************************************************************************/
 	/**
 	 * @brief Callback function for when the monitored parent node's state changes.
+	 * @details Marks the owning node dirty rather than re-evaluating it synchronously; the tree's dirty queue
+	 * re-evaluates it after the parent has settled.
 	 */
 	UFUNCTION()
 	void OnParentNodeStateChanged();
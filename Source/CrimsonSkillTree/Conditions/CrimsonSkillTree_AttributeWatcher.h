@@ -0,0 +1,283 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AbilitySystemComponent.h"
+#include "Algo/BinarySearch.h"
+#include "CrimsonSkillTree_ActivationCondition_AttributeRequirement.h"
+
+/** @brief Called with the manager resource slot whose attribute-backed budget changed. */
+DECLARE_DELEGATE_OneParam(FCrimsonSkillTree_OnBudgetAttributeChanged, int32 /*ResourceSlot*/);
+
+/**
+ * @struct FCrimsonSkillTree_AttributeWatcher
+ * @brief Manager-owned fan-out of ASC attribute changes to AttributeRequirement conditions and resource budgets.
+ * @details Subscribes to the ASC once per distinct FGameplayAttribute, regardless of how many conditions or budgets
+ * watch it.
+ * Each attribute's watchers are kept sorted by threshold. A condition's result can only change when the attribute
+ * moves across its threshold, so on a change from Old to New only the watchers with a threshold in
+ * [min(Old, New), max(Old, New)] are notified. Those are found with two binary searches, so a regen tick costs
+ * O(log n + crossings) instead of one delegate call per condition. Budget watchers are notified on every change, since
+ * any change moves the budget.
+ * Game thread only.
+ */
+struct FCrimsonSkillTree_AttributeWatcher
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	FCrimsonSkillTree_AttributeWatcher() = default;
+
+	// Delegates are bound to this instance's address.
+	FCrimsonSkillTree_AttributeWatcher(const FCrimsonSkillTree_AttributeWatcher&) = delete;
+	FCrimsonSkillTree_AttributeWatcher& operator=(const FCrimsonSkillTree_AttributeWatcher&) = delete;
+
+	~FCrimsonSkillTree_AttributeWatcher() { Reset(); }
+
+	/**
+	 * @brief Starts notifying a condition when its attribute crosses its threshold.
+	 * @details Adding a condition that is already watched replaces its entry, so it is never notified twice.
+	 * @param InAbilitySystemComponent The ASC that owns the attribute. All conditions of one manager share it.
+	 * @param Condition The condition to notify.
+	 */
+	void AddWatcher(UAbilitySystemComponent* InAbilitySystemComponent, UCrimsonSkillTree_ActivationCondition_AttributeRequirement* Condition)
+	{
+		if (!InAbilitySystemComponent || !Condition || !Condition->GetRequiredAttribute().IsValid())
+		{
+			return;
+		}
+
+		FWatchedAttribute& Watched = FindOrSubscribe(InAbilitySystemComponent, Condition->GetRequiredAttribute());
+		Watched.Entries.RemoveAll([Condition](const FThresholdEntry& Entry) { return Entry.Condition.Get() == Condition || !Entry.Condition.IsValid(); });
+		const FThresholdEntry NewEntry{ Condition->GetRequiredValue(), Condition };
+		const int32 InsertIndex = Algo::UpperBoundBy(Watched.Entries, NewEntry.Threshold, &FThresholdEntry::Threshold);
+		Watched.Entries.Insert(NewEntry, InsertIndex);
+	}
+
+	/**
+	 * @brief Stops notifying a condition. Unsubscribes from the ASC when the attribute has no watchers left.
+	 * @param Condition The condition to remove.
+	 */
+	void RemoveWatcher(const UCrimsonSkillTree_ActivationCondition_AttributeRequirement* Condition)
+	{
+		if (!Condition)
+		{
+			return;
+		}
+
+		FWatchedAttribute* Watched = WatchedAttributes.Find(Condition->GetRequiredAttribute());
+		if (!Watched)
+		{
+			return;
+		}
+
+		Watched->Entries.RemoveAll([Condition](const FThresholdEntry& Entry) { return Entry.Condition.Get() == Condition || !Entry.Condition.IsValid(); });
+		UnsubscribeIfUnused(Condition->GetRequiredAttribute(), *Watched);
+	}
+
+	/**
+	 * @brief Starts notifying OnBudgetAttributeChanged whenever an attribute that backs a resource budget changes.
+	 * @param InAbilitySystemComponent The ASC that owns the attribute.
+	 * @param Attribute The attribute backing the budget.
+	 * @param ResourceSlot The manager resource slot passed to OnBudgetAttributeChanged.
+	 */
+	void AddBudgetWatcher(UAbilitySystemComponent* InAbilitySystemComponent, const FGameplayAttribute& Attribute, int32 ResourceSlot)
+	{
+		if (!InAbilitySystemComponent || !Attribute.IsValid())
+		{
+			return;
+		}
+
+		FindOrSubscribe(InAbilitySystemComponent, Attribute).BudgetSlots.AddUnique(ResourceSlot);
+	}
+
+	/**
+	 * @brief Stops every budget notification. Unsubscribes from attributes no condition watches.
+	 */
+	void RemoveAllBudgetWatchers()
+	{
+		for (auto It = WatchedAttributes.CreateIterator(); It; ++It)
+		{
+			It->Value.BudgetSlots.Reset();
+			if (It->Value.Entries.IsEmpty())
+			{
+				if (UAbilitySystemComponent* ASC = AbilitySystemComponent.Get())
+				{
+					ASC->GetGameplayAttributeValueChangeDelegate(It->Key).Remove(It->Value.ChangedHandle);
+				}
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	/**
+	 * @brief Removes every watcher and every ASC subscription.
+	 */
+	void Reset()
+	{
+		if (UAbilitySystemComponent* ASC = AbilitySystemComponent.Get())
+		{
+			for (const TPair<FGameplayAttribute, FWatchedAttribute>& Pair : WatchedAttributes)
+			{
+				ASC->GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value.ChangedHandle);
+			}
+		}
+		WatchedAttributes.Reset();
+		AbilitySystemComponent.Reset();
+	}
+
+	/** @brief Gets the number of ASC subscriptions, one per distinct attribute. */
+	int32 GetNumSubscriptions() const { return WatchedAttributes.Num(); }
+
+	/** @brief Called by HandleAttributeChanged for every budget slot bound to the changed attribute. Bound by the manager. */
+	FCrimsonSkillTree_OnBudgetAttributeChanged OnBudgetAttributeChanged;
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	struct FWatchedAttribute;
+
+	/**
+	 * @brief Gets the entry of an attribute, subscribing to the ASC the first time the attribute is watched.
+	 * @details Switching to a different ASC moves every existing subscription over through RebindAbilitySystemComponent.
+	 */
+	FWatchedAttribute& FindOrSubscribe(UAbilitySystemComponent* InAbilitySystemComponent, const FGameplayAttribute& Attribute)
+	{
+		if (AbilitySystemComponent.Get() != InAbilitySystemComponent)
+		{
+			RebindAbilitySystemComponent(InAbilitySystemComponent);
+		}
+
+		FWatchedAttribute& Watched = WatchedAttributes.FindOrAdd(Attribute);
+		if (!Watched.ChangedHandle.IsValid())
+		{
+			Watched.ChangedHandle = InAbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute)
+				.AddRaw(this, &FCrimsonSkillTree_AttributeWatcher::HandleAttributeChanged);
+		}
+		return Watched;
+	}
+
+	/**
+	 * @brief Moves every subscription from the current ASC to another one, e.g. after a respawn or possession change.
+	 * @details Watchers and budget slots are kept. Every budget slot and every watching condition is notified once
+	 * afterwards, since the attribute values of the new ASC are unrelated to the old ones.
+	 * @param InAbilitySystemComponent The ASC to subscribe on from now on.
+	 */
+	void RebindAbilitySystemComponent(UAbilitySystemComponent* InAbilitySystemComponent)
+	{
+		UAbilitySystemComponent* OldASC = AbilitySystemComponent.Get();
+		AbilitySystemComponent = InAbilitySystemComponent;
+
+		for (TPair<FGameplayAttribute, FWatchedAttribute>& Pair : WatchedAttributes)
+		{
+			if (OldASC)
+			{
+				OldASC->GetGameplayAttributeValueChangeDelegate(Pair.Key).Remove(Pair.Value.ChangedHandle);
+			}
+			Pair.Value.ChangedHandle = InAbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Pair.Key)
+				.AddRaw(this, &FCrimsonSkillTree_AttributeWatcher::HandleAttributeChanged);
+		}
+
+		// Copy the conditions first: a notified condition may end monitoring and remove itself.
+		TArray<TWeakObjectPtr<UCrimsonSkillTree_ActivationCondition_AttributeRequirement>, TInlineAllocator<8>> Rebound;
+		for (const TPair<FGameplayAttribute, FWatchedAttribute>& Pair : WatchedAttributes)
+		{
+			for (const int32 ResourceSlot : Pair.Value.BudgetSlots)
+			{
+				OnBudgetAttributeChanged.ExecuteIfBound(ResourceSlot);
+			}
+			for (const FThresholdEntry& Entry : Pair.Value.Entries)
+			{
+				Rebound.Add(Entry.Condition);
+			}
+		}
+		for (const TWeakObjectPtr<UCrimsonSkillTree_ActivationCondition_AttributeRequirement>& Condition : Rebound)
+		{
+			if (Condition.IsValid())
+			{
+				Condition->OnWatchedThresholdCrossed();
+			}
+		}
+	}
+
+	/** @brief Drops the ASC subscription of an attribute once neither conditions nor budgets watch it. */
+	void UnsubscribeIfUnused(const FGameplayAttribute& Attribute, FWatchedAttribute& Watched)
+	{
+		if (!Watched.Entries.IsEmpty() || !Watched.BudgetSlots.IsEmpty())
+		{
+			return;
+		}
+
+		if (UAbilitySystemComponent* ASC = AbilitySystemComponent.Get())
+		{
+			ASC->GetGameplayAttributeValueChangeDelegate(Attribute).Remove(Watched.ChangedHandle);
+		}
+		WatchedAttributes.Remove(Attribute);
+	}
+	/**
+	 * @brief Notifies the conditions whose threshold lies between the old and new value.
+	 * @param ChangeData The attribute change reported by the ASC.
+	 */
+	void HandleAttributeChanged(const FOnAttributeChangeData& ChangeData)
+	{
+		FWatchedAttribute* Watched = WatchedAttributes.Find(ChangeData.Attribute);
+		if (!Watched || ChangeData.OldValue == ChangeData.NewValue)
+		{
+			return;
+		}
+
+		// Budgets first: a crossed condition re-evaluates against the budget cache.
+		for (const int32 ResourceSlot : Watched->BudgetSlots)
+		{
+			OnBudgetAttributeChanged.ExecuteIfBound(ResourceSlot);
+		}
+
+		const float Low = FMath::Min(ChangeData.OldValue, ChangeData.NewValue);
+		const float High = FMath::Max(ChangeData.OldValue, ChangeData.NewValue);
+		const int32 First = Algo::LowerBoundBy(Watched->Entries, Low, &FThresholdEntry::Threshold);
+		const int32 Last = Algo::UpperBoundBy(Watched->Entries, High, &FThresholdEntry::Threshold);
+
+		// Copy the crossed range first: a notified condition may end monitoring and remove itself.
+		TArray<TWeakObjectPtr<UCrimsonSkillTree_ActivationCondition_AttributeRequirement>, TInlineAllocator<8>> Crossed;
+		for (int32 Index = First; Index < Last; ++Index)
+		{
+			Crossed.Add(Watched->Entries[Index].Condition);
+		}
+		for (const TWeakObjectPtr<UCrimsonSkillTree_ActivationCondition_AttributeRequirement>& Condition : Crossed)
+		{
+			if (Condition.IsValid())
+			{
+				Condition->OnWatchedThresholdCrossed();
+			}
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	struct FThresholdEntry
+	{
+		float Threshold = 0.f;
+		TWeakObjectPtr<UCrimsonSkillTree_ActivationCondition_AttributeRequirement> Condition;
+	};
+
+	struct FWatchedAttribute
+	{
+		/** @brief The single ASC subscription for this attribute. */
+		FDelegateHandle ChangedHandle;
+
+		/** @brief Watching conditions, sorted by ascending threshold. */
+		TArray<FThresholdEntry> Entries;
+
+		/** @brief Manager resource slots whose budget this attribute backs. Usually none or one. */
+		TArray<int32, TInlineAllocator<1>> BudgetSlots;
+	};
+
+	/** @brief The ASC all subscriptions are made on. */
+	TWeakObjectPtr<UAbilitySystemComponent> AbilitySystemComponent;
+
+	/** @brief Attribute -> subscription and sorted watchers. */
+	TMap<FGameplayAttribute, FWatchedAttribute> WatchedAttributes;
+};
@@ -0,0 +1,319 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_ActivationConditionBase.h"
+#include "CrimsonSkillTree_ActivationCondition_AttributeRequirement.h"
+#include "CrimsonSkillTree_ActivationCondition_ParentLevel.h"
+#include "CrimsonSkillTree_ActivationCondition_ResourcePointsSpent.h"
+#include "CrimsonSkillTree_Condition_Composite.h"
+#include "CrimsonSkillTree/Nodes/Cost/CrimsonSkillTree_ResourceRegistry.h"
+
+/**
+ * @enum ECrimsonCompiledConditionOp
+ * @brief Instruction set of FCrimsonSkillTree_CompiledCondition.
+ */
+enum class ECrimsonCompiledConditionOp : uint8
+{
+	/** Levels[Operand] >= IntValue. */
+	ParentLevel,
+	/** Allocated amount of resource Operand >= IntValue. */
+	ResourceSpent,
+	/** Attributes[Operand] compared against FloatValue with Comparison. */
+	Attribute,
+	/** Starts an AND block that ends at SkipTo. */
+	And,
+	/** Starts an OR block that ends at SkipTo. */
+	Or,
+	/** Calls IsConditionMet on FallbackConditions[Operand]. */
+	Fallback
+};
+
+/**
+ * @struct FCrimsonCompiledConditionInstruction
+ * @brief A single instruction of a compiled condition program.
+ */
+struct FCrimsonCompiledConditionInstruction
+{
+	ECrimsonCompiledConditionOp Op = ECrimsonCompiledConditionOp::Fallback;
+
+	/** @brief Comparison for Attribute instructions. */
+	ECrimsonAttributeComparisonType Comparison = ECrimsonAttributeComparisonType::GreaterThanOrEqualTo;
+
+	/** @brief Dense node index, ResourceId, attribute index or fallback index, depending on Op. */
+	int32 Operand = INDEX_NONE;
+
+	/** @brief Required level or amount. */
+	int32 IntValue = 0;
+
+	/** @brief Required attribute value. */
+	float FloatValue = 0.f;
+
+	/** @brief For And/Or: index of the first instruction after the block. */
+	int32 SkipTo = INDEX_NONE;
+};
+
+/**
+ * @struct FCrimsonCompiledConditionContext
+ * @brief The data a compiled condition program reads, gathered once by the caller per evaluation.
+ */
+struct FCrimsonCompiledConditionContext
+{
+	/** @brief The node the conditions belong to, passed to fallback conditions. */
+	const UCrimsonSkillTree_Node* OwningNode = nullptr;
+
+	/** @brief Current level per dense node index of the node's tree. */
+	TConstArrayView<int32> Levels;
+
+	/** @brief Manager resource slot per ResourceId (UCrimsonSkillTreeManager). */
+	TConstArrayView<int32> SlotByResourceId;
+
+	/** @brief Allocated amount per manager resource slot. */
+	TConstArrayView<int32> AllocatedAmountBySlot;
+
+	/** @brief The owner's ability system component, may be nullptr. */
+	const UAbilitySystemComponent* AbilitySystemComponent = nullptr;
+};
+
+/**
+ * @struct FCrimsonSkillTree_CompiledCondition
+ * @brief A node's ActivationConditions compiled into a flat instruction array.
+ * @details The built-in native conditions (ParentLevel, ResourcePointsSpent, AttributeRequirement and the AND/OR
+ * composites) are lowered to instructions whose operands are already resolved: parent GUIDs to dense node indices and
+ * cost definitions to ResourceIds. Composites become And/Or block headers with a skip offset, so a short-circuit jumps
+ * over the rest of the block instead of recursing through UObjects. Only classes that match exactly are lowered; any
+ * other condition, including Blueprint or native subclasses of the built-in ones, becomes a Fallback instruction that
+ * calls its IsConditionMet UFUNCTION.
+ * The program is a pure check: it does not broadcast failure messages. Callers that need to report why a condition
+ * failed run the UFUNCTION path after the program returns false.
+ */
+struct FCrimsonSkillTree_CompiledCondition
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+
+	/**
+	 * @brief Gets the approximate heap footprint of the program, for memory reports.
+	 * @return The allocated size in bytes.
+	 */
+	SIZE_T GetAllocatedSize() const
+	{
+		return Instructions.GetAllocatedSize() + Attributes.GetAllocatedSize() + FallbackConditions.GetAllocatedSize();
+	}
+
+	/**
+	 * @brief Reports FallbackConditions to the garbage collector.
+	 * @details Called through FCrimsonSkillTree_SharedDefinition::AddReferencedObjects by every tree holding the program.
+	 * @param Collector The reference collector of the current GC pass.
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector) const
+	{
+		for (const UCrimsonSkillTree_ActivationConditionBase* Condition : FallbackConditions)
+		{
+			Collector.AddReferencedObject(Condition);
+		}
+	}
+
+	// ~Compilation
+	// =============================================================================================================
+	/**
+	 * @brief Compiles a node's condition list. The top level is an implicit AND.
+	 * @param Conditions The template node's ActivationConditions.
+	 * @param FindNodeIndex Maps a node GUID to its dense index in the node's tree, or INDEX_NONE.
+	 */
+	void Compile(TConstArrayView<TObjectPtr<UCrimsonSkillTree_ActivationConditionBase>> Conditions, TFunctionRef<int32(const FGuid&)> FindNodeIndex)
+	{
+		Reset();
+		for (const UCrimsonSkillTree_ActivationConditionBase* Condition : Conditions)
+		{
+			CompileCondition(Condition, FindNodeIndex);
+		}
+		bCompiled = true;
+	}
+
+	void Reset()
+	{
+		Instructions.Reset();
+		Attributes.Reset();
+		FallbackConditions.Reset();
+		bCompiled = false;
+	}
+
+	bool IsCompiled() const { return bCompiled; }
+
+	/**
+	 * @brief Checks whether the program needs the owner's ability system component.
+	 * @return True if it contains at least one Attribute instruction.
+	 */
+	bool NeedsAbilitySystemComponent() const { return Attributes.Num() > 0; }
+
+	// ~Evaluation
+	// =============================================================================================================
+	/**
+	 * @brief Runs the program.
+	 * @param Context The data to evaluate against.
+	 * @return True if every top-level condition is met.
+	 */
+	bool Evaluate(const FCrimsonCompiledConditionContext& Context) const
+	{
+		int32 ProgramCounter = 0;
+		return EvaluateBlock(ProgramCounter, Instructions.Num(), false, Context);
+	}
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	void CompileCondition(const UCrimsonSkillTree_ActivationConditionBase* Condition, TFunctionRef<int32(const FGuid&)> FindNodeIndex)
+	{
+		if (!Condition)
+		{
+			return;
+		}
+
+		const UClass* ConditionClass = Condition->GetClass();
+		if (ConditionClass == UCrimsonSkillTree_Condition_AND::StaticClass() || ConditionClass == UCrimsonSkillTree_Condition_OR::StaticClass())
+		{
+			const int32 HeaderIndex = Instructions.AddDefaulted();
+			Instructions[HeaderIndex].Op = ConditionClass == UCrimsonSkillTree_Condition_OR::StaticClass() ? ECrimsonCompiledConditionOp::Or : ECrimsonCompiledConditionOp::And;
+			for (const UCrimsonSkillTree_ActivationConditionBase* Child : CastChecked<UCrimsonSkillTree_Condition_CompositeBase>(Condition)->ChildConditions)
+			{
+				CompileCondition(Child, FindNodeIndex);
+			}
+			Instructions[HeaderIndex].SkipTo = Instructions.Num();
+			return;
+		}
+
+		FCrimsonCompiledConditionInstruction Instruction;
+		if (ConditionClass == UCrimsonSkillTree_ActivationCondition_ParentLevel::StaticClass())
+		{
+			const UCrimsonSkillTree_ActivationCondition_ParentLevel* ParentLevel = CastChecked<UCrimsonSkillTree_ActivationCondition_ParentLevel>(Condition);
+			Instruction.Operand = FindNodeIndex(ParentLevel->TargetParentNodeGuid);
+			Instruction.IntValue = ParentLevel->RequiredLevel;
+			Instruction.Op = ECrimsonCompiledConditionOp::ParentLevel;
+		}
+		else if (ConditionClass == UCrimsonSkillTree_ActivationCondition_ResourcePointsSpent::StaticClass())
+		{
+			const UCrimsonSkillTree_ActivationCondition_ResourcePointsSpent* ResourceSpent = CastChecked<UCrimsonSkillTree_ActivationCondition_ResourcePointsSpent>(Condition);
+			Instruction.Operand = FCrimsonSkillTree_ResourceRegistry::Get().FindOrAddResourceId(ResourceSpent->RequiredResource);
+			Instruction.IntValue = ResourceSpent->RequiredAmountSpent;
+			Instruction.Op = ECrimsonCompiledConditionOp::ResourceSpent;
+		}
+		else if (ConditionClass == UCrimsonSkillTree_ActivationCondition_AttributeRequirement::StaticClass())
+		{
+			const UCrimsonSkillTree_ActivationCondition_AttributeRequirement* AttributeRequirement = CastChecked<UCrimsonSkillTree_ActivationCondition_AttributeRequirement>(Condition);
+			Instruction.Operand = Attributes.Add(AttributeRequirement->GetRequiredAttribute());
+			Instruction.FloatValue = AttributeRequirement->GetRequiredValue();
+			Instruction.Comparison = AttributeRequirement->GetComparisonType();
+			Instruction.Op = ECrimsonCompiledConditionOp::Attribute;
+		}
+
+		// Unresolvable parent references keep the original behavior (and its failure message) through the fallback.
+		if (Instruction.Op == ECrimsonCompiledConditionOp::Fallback || (Instruction.Op == ECrimsonCompiledConditionOp::ParentLevel && Instruction.Operand == INDEX_NONE))
+		{
+			Instruction = FCrimsonCompiledConditionInstruction();
+			Instruction.Operand = FallbackConditions.Add(Condition);
+		}
+		Instructions.Add(Instruction);
+	}
+
+	/**
+	 * @brief Evaluates instructions [ProgramCounter, End) as an AND or OR block, short-circuiting on the first decisive result.
+	 * @param ProgramCounter The current instruction, advanced to End on return.
+	 * @param End The first instruction after the block.
+	 * @param bIsOr True for OR semantics, false for AND.
+	 * @param Context The data to evaluate against.
+	 * @return The block's result. An empty AND is true and an empty OR is false.
+	 */
+	bool EvaluateBlock(int32& ProgramCounter, int32 End, bool bIsOr, const FCrimsonCompiledConditionContext& Context) const
+	{
+		while (ProgramCounter < End)
+		{
+			const FCrimsonCompiledConditionInstruction& Instruction = Instructions[ProgramCounter];
+			bool bResult;
+			if (Instruction.Op == ECrimsonCompiledConditionOp::And || Instruction.Op == ECrimsonCompiledConditionOp::Or)
+			{
+				int32 InnerCounter = ProgramCounter + 1;
+				bResult = EvaluateBlock(InnerCounter, Instruction.SkipTo, Instruction.Op == ECrimsonCompiledConditionOp::Or, Context);
+				ProgramCounter = Instruction.SkipTo;
+			}
+			else
+			{
+				bResult = EvaluateLeaf(Instruction, Context);
+				++ProgramCounter;
+			}
+
+			if (bResult == bIsOr)
+			{
+				ProgramCounter = End;
+				return bResult;
+			}
+		}
+		return !bIsOr;
+	}
+
+	bool EvaluateLeaf(const FCrimsonCompiledConditionInstruction& Instruction, const FCrimsonCompiledConditionContext& Context) const
+	{
+		switch (Instruction.Op)
+		{
+		case ECrimsonCompiledConditionOp::ParentLevel:
+			return Context.Levels.IsValidIndex(Instruction.Operand) && Context.Levels[Instruction.Operand] >= Instruction.IntValue;
+
+		case ECrimsonCompiledConditionOp::ResourceSpent:
+		{
+			const int32 Slot = Context.SlotByResourceId.IsValidIndex(Instruction.Operand) ? Context.SlotByResourceId[Instruction.Operand] : INDEX_NONE;
+			const int32 Spent = Context.AllocatedAmountBySlot.IsValidIndex(Slot) ? Context.AllocatedAmountBySlot[Slot] : 0;
+			return Spent >= Instruction.IntValue;
+		}
+
+		case ECrimsonCompiledConditionOp::Attribute:
+		{
+			if (!Context.AbilitySystemComponent)
+			{
+				return false;
+			}
+			const float Value = Context.AbilitySystemComponent->GetNumericAttribute(Attributes[Instruction.Operand]);
+			switch (Instruction.Comparison)
+			{
+			case ECrimsonAttributeComparisonType::GreaterThan:			return Value > Instruction.FloatValue;
+			case ECrimsonAttributeComparisonType::LessThan:				return Value < Instruction.FloatValue;
+			case ECrimsonAttributeComparisonType::EqualTo:				return FMath::IsNearlyEqual(Value, Instruction.FloatValue);
+			case ECrimsonAttributeComparisonType::NotEqualTo:			return !FMath::IsNearlyEqual(Value, Instruction.FloatValue);
+			case ECrimsonAttributeComparisonType::GreaterThanOrEqualTo:	return Value >= Instruction.FloatValue;
+			case ECrimsonAttributeComparisonType::LessThanOrEqualTo:	return Value <= Instruction.FloatValue;
+			default:													return false;
+			}
+		}
+
+		case ECrimsonCompiledConditionOp::Fallback:
+		{
+			const UCrimsonSkillTree_ActivationConditionBase* Condition = FallbackConditions[Instruction.Operand];
+			return Condition && Condition->IsConditionMet(Context.OwningNode);
+		}
+
+		default:
+			return false;
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief The program, in prefix order. */
+	TArray<FCrimsonCompiledConditionInstruction> Instructions;
+
+	/** @brief Attributes referenced by Attribute instructions. */
+	TArray<FGameplayAttribute> Attributes;
+
+	/**
+	 * @brief Conditions evaluated through their UFUNCTION. Owned by the template node's ActivationConditions and
+	 * shared by every actor, so IsConditionMet is always called with the evaluating actor's node as OwningNode.
+	 * Not a UPROPERTY; kept alive by AddReferencedObjects.
+	 */
+	TArray<const UCrimsonSkillTree_ActivationConditionBase*> FallbackConditions;
+
+	/** @brief Set once Compile has run. */
+	bool bCompiled = false;
+};
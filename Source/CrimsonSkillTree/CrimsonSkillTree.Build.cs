@@ -16,6 +16,7 @@ public class CrimsonSkillTree : ModuleRules
                 "GameFeatures",
                 "ModularGameplay",
                 "ModelViewViewModel",
+                "NetCore",
                 "UMG"
             ]
         );
@@ -35,9 +36,7 @@ public class CrimsonSkillTree : ModuleRules
                 // Slate & UI
                 "CommonUI",
                 "Slate",
-                "SlateCore",
-                "NetCore"
-                
+                "SlateCore"
             ]
         );
 
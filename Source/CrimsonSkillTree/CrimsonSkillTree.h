@@ -2,6 +2,9 @@
 
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
+#include "Nodes/CrimsonSkillTree_NodeStateBlock.h"
+#include "Nodes/CrimsonSkillTree_ReachabilityIndex.h"
+#include "Nodes/CrimsonSkillTree_DirtyQueue.h"
 #include "CrimsonSkillTree.generated.h"
 
 class UCrimsonSkillTreeWidget_LineDrawingPolicyBase;
@@ -74,26 +77,188 @@ public:
 
 	// ~UObject Overrides
 	// =============================================================================================================
+	/** @brief Rebuilds the shared definition of template assets, so it is ready before any manager instances the tree. */
 	virtual void PostLoad() override;
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 
+	/** @brief Reports the template nodes and fallback conditions of the held shared definition, which are not UPROPERTYs. */
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+	{
+		Super::AddReferencedObjects(InThis, Collector);
+		if (const FCrimsonSkillTree_SharedDefinition* Definition = CastChecked<UCrimsonSkillTree>(InThis)->SharedDefinition.Get())
+		{
+			Definition->AddReferencedObjects(Collector);
+		}
+	}
+#if WITH_EDITOR
+	/** @brief Rebuilds the shared definition after the asset is edited. Node edits do the same through their own PostEditChangeProperty. */
+	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	/** @brief Rebuilds the shared definition after an undo or redo changed the asset. */
+	virtual void PostEditUndo() override;
+#endif
+
 	// ~Core Functionality
 	// =============================================================================================================
 	/**
 	 * @brief Resets all nodes in this tree to their default initial state.
-	 * @details This is crucial before loading a saved game to ensure a clean slate.
+	 * @details This is crucial before loading a saved game to ensure a clean slate. The level/state arrays are
+	 * cleared in a single pass through ResetNodeStates before per-node shutdown runs.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree")
 	void ResetTreeToDefaults();
 
 	/**
 	 * @brief Finds a node within this tree by its unique GUID.
+	 * @details Uses NodeGuidLookup when it has been built, falling back to a scan of AllNodes otherwise (e.g. on the template asset in the editor).
 	 * @param InNodeGUID The GUID of the node to find.
 	 * @return The found UCrimsonSkillTree_Node, or nullptr if not found.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree")
 	UCrimsonSkillTree_Node* FindNodeByGUID(const FGuid& InNodeGUID) const;
 
+	/**
+	 * @brief Rebuilds the GUID to node lookup from AllNodes.
+	 * @details Called by the manager when a runtime instance is created. The lookup is transient and never serialized.
+	 */
+	void BuildNodeGuidLookup();
+
+	/**
+	 * @brief Empties the GUID to node lookup. Called when the runtime instance is shut down.
+	 */
+	void ClearNodeGuidLookup() { NodeGuidLookup.Empty(); }
+
+	/**
+	 * @brief Gets the GUID to node lookup of this tree.
+	 * @return A const reference to the lookup map. Empty if BuildNodeGuidLookup has not been called.
+	 */
+	const TMap<FGuid, TObjectPtr<UCrimsonSkillTree_Node>>& GetNodeGuidLookup() const { return NodeGuidLookup; }
+
+	// ~Runtime State Block
+	// =============================================================================================================
+	/**
+	 * @brief Assigns dense node indices and builds the struct-of-arrays state block from AllNodes.
+	 * @details Called once by the manager when the runtime instance is created, after SetSourceTemplate. Pins the
+	 * template's current shared definition on this instance, so the state block, reachability index, dirty queue and
+	 * every later GetSharedDefinition call agree on the same dense indices even if the template is rebuilt afterwards.
+	 */
+	void BuildNodeStateBlock()
+	{
+		check(IsRuntimeInstance());
+		SharedDefinition = SourceTemplate->GetSharedDefinition();
+		NodeStateBlock.Build(AllNodes, SharedDefinition);
+		ReachabilityIndex.Build(NodeStateBlock);
+		DirtyQueue.Init(NodeStateBlock.GetDefinition());
+	}
+
+	/**
+	 * @brief Gets the contiguous level/state arrays and CSR adjacency of this runtime instance.
+	 * @return The state block. Empty on template assets that have not been instanced.
+	 */
+	const FCrimsonSkillTree_NodeStateBlock& GetNodeStateBlock() const { return NodeStateBlock; }
+	FCrimsonSkillTree_NodeStateBlock& GetNodeStateBlock() { return NodeStateBlock; }
+
+	/**
+	 * @brief Gets the maintained reachability index over the active nodes of this runtime instance.
+	 * @details Nodes notify it through SetNodeLevelAndState whenever they cross between level 0 and level > 0.
+	 * @return The reachability index.
+	 */
+	const FCrimsonSkillTree_ReachabilityIndex& GetReachabilityIndex() const { return ReachabilityIndex; }
+	FCrimsonSkillTree_ReachabilityIndex& GetReachabilityIndex() { return ReachabilityIndex; }
+
+	/**
+	 * @brief Resets every level and state of the state block in one pass and rebuilds the reachability index from it.
+	 * @details The block reset bypasses SetNodeLevelAndState, so the index is told through OnAllStatesReset instead of
+	 * once per node. Use this rather than calling FCrimsonSkillTree_NodeStateBlock::ResetAllStates directly.
+	 */
+	void ResetNodeStates()
+	{
+		NodeStateBlock.ResetAllStates();
+		ReachabilityIndex.OnAllStatesReset();
+	}
+
+	// ~Dirty Propagation
+	// =============================================================================================================
+	/**
+	 * @brief Queues a node for UpdateNodeOverallState and asks the owning manager to flush this tree.
+	 * @details The flush happens on the next tick, or when the manager's current transaction ends.
+	 * @param Node The node whose inputs changed.
+	 */
+	void MarkNodeDirty(const UCrimsonSkillTree_Node* Node);
+
+	/**
+	 * @brief Runs UpdateNodeOverallState once for every queued node, parents before children.
+	 * @return The number of nodes evaluated.
+	 */
+	int32 FlushDirtyNodes();
+
+	bool HasDirtyNodes() const { return !DirtyQueue.IsEmpty(); }
+
+	// ~Shared Definition
+	// =============================================================================================================
+	/**
+	 * @brief Gets the immutable definition shared by this asset and every runtime instance created from it.
+	 * @details Runtime instances return the definition pinned by BuildNodeStateBlock, which is the template's copy at
+	 * the time, so all actors using the same asset share one copy. Template assets build it eagerly in PostLoad and
+	 * after every edit; this getter never builds.
+	 * @return The shared definition, or null on a template that has not been loaded or built yet, or an instance whose
+	 * state block has not been built.
+	 */
+	TSharedPtr<const FCrimsonSkillTree_SharedDefinition> GetSharedDefinition() const { return SharedDefinition; }
+
+	/**
+	 * @brief [Template] Builds the shared definition from AllNodes and RootNode, replacing the previous one.
+	 * @details Called from PostLoad, PostEditChangeProperty and PostEditUndo, and by the manager for templates that
+	 * were created in memory and never loaded. Instances that already hold the old definition keep it alive until they
+	 * are shut down. Game thread only.
+	 */
+	void RebuildSharedDefinition()
+	{
+		check(IsInGameThread());
+		check(!IsRuntimeInstance());
+		const TSharedRef<FCrimsonSkillTree_SharedDefinition> NewDefinition = MakeShared<FCrimsonSkillTree_SharedDefinition>();
+		NewDefinition->Build(AllNodes, RootNode);
+		SharedDefinition = NewDefinition;
+	}
+
+	/**
+	 * @brief [Template] Makes sure the shared definition exists, building it if this template was never loaded.
+	 * @return The shared definition, never null.
+	 */
+	TSharedPtr<const FCrimsonSkillTree_SharedDefinition> EnsureSharedDefinition()
+	{
+		if (!SharedDefinition.IsValid())
+		{
+			RebuildSharedDefinition();
+		}
+		return SharedDefinition;
+	}
+
+	/**
+	 * @brief [Template] Drops the shared definition. Called when the asset's graph or a node changes in the editor,
+	 * before the definition is rebuilt.
+	 * @details Instances that already hold the old definition keep it alive until they are shut down.
+	 */
+	void InvalidateSharedDefinition() { check(IsInGameThread()); SharedDefinition.Reset(); }
+
+	/**
+	 * @brief Marks this tree as a runtime instance of the given template asset.
+	 * @param InSourceTemplate The asset this instance was created from.
+	 */
+	void SetSourceTemplate(const UCrimsonSkillTree* InSourceTemplate) { SourceTemplate = InSourceTemplate; }
+
+	/**
+	 * @brief Gets the template asset this runtime instance was created from.
+	 * @return The template asset, or nullptr if this tree is itself a template.
+	 */
+	const UCrimsonSkillTree* GetSourceTemplate() const { return SourceTemplate; }
+
+	/**
+	 * @brief Checks whether this tree is a runtime instance rather than a template asset.
+	 * @return True if this tree was created by a manager.
+	 */
+	bool IsRuntimeInstance() const { return SourceTemplate != nullptr; }
+
 	/**
 	 * @brief Gets a const reference to the flat list of all nodes contained within this skill tree.
 	 * @return A const TArray reference of all nodes.
@@ -223,4 +388,28 @@ public:
 	/** @brief A weak pointer to the manager component that owns this runtime instance. */
 	UPROPERTY(Transient)
 	TWeakObjectPtr<UCrimsonSkillTreeManager> OwningManager;
+
+private:
+	/** @brief Transient GUID to node index over AllNodes, built once per runtime instance by BuildNodeGuidLookup. */
+	UPROPERTY(Transient)
+	TMap<FGuid, TObjectPtr<UCrimsonSkillTree_Node>> NodeGuidLookup;
+
+	/** @brief Per-instance struct-of-arrays node state. Nodes are kept alive by AllNodes. */
+	FCrimsonSkillTree_NodeStateBlock NodeStateBlock;
+
+	/** @brief Active parent counts and dominator tree over NodeStateBlock. */
+	FCrimsonSkillTree_ReachabilityIndex ReachabilityIndex;
+
+	/** @brief Nodes awaiting UpdateNodeOverallState, drained in topological order. */
+	FCrimsonSkillTree_DirtyQueue DirtyQueue;
+
+	/** @brief The template asset this runtime instance was created from. Null on template assets. */
+	UPROPERTY(Transient)
+	TObjectPtr<const UCrimsonSkillTree> SourceTemplate;
+
+	/**
+	 * @brief Immutable definition. Built by RebuildSharedDefinition on template assets; on runtime instances, the
+	 * template's definition pinned by BuildNodeStateBlock.
+	 */
+	TSharedPtr<const FCrimsonSkillTree_SharedDefinition> SharedDefinition;
 };
@@ -5,41 +5,188 @@
 #include "CrimsonSkillTree.h"
 #include "GameplayTagContainer.h"
 #include "ICrimsonSkillTreeInterface.h"
+#include "SimulationDataCollector.h"
 #include "Nodes/Cost/CrimsonSkillTree_NodeCost.h"
+#include "Nodes/Cost/CrimsonSkillTree_ResourceRegistry.h"
 #include "Nodes/CrimsonSkillTree_Node.h"
 #include "Nodes/ICrimsonSkillTree_NodeAction.h"
+#include "Conditions/CrimsonSkillTree_AttributeWatcher.h"
+#include "Events/CrimsonSkillTree_EventCoalescer.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "CrimsonSkillTreeManager.generated.h"
 
 struct FCrimsonSkillTree_SaveGameData;
 class UCrimsonSkillTree_SaveGame;
+class UCrimsonSkillTreeManager;
+struct FReplicatedResourceAllocationArray;
+struct FReplicatedNodeStateArray;
 
 /**
  * @struct FReplicatedResourceAllocation
  * @brief Holds the amount of a specific resource that has been spent and replicated.
+ * @details The resource is identified by its manager resource slot, a deterministic index derived from the order of
+ * ConfiguredSkillTrees (see UCrimsonSkillTreeManager::RebuildResourceSlots). Server and clients derive the same slots
+ * from the same replicated configuration, so only two packed integers go over the wire. When the configuration
+ * changes, the server remaps existing entries to the new slots and re-sends them.
  */
 USTRUCT()
-struct FReplicatedResourceAllocation
+struct FReplicatedResourceAllocation : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
 	UPROPERTY()
-	FNodeCostDefinition CostDefinition;
+	int32 ResourceSlot = INDEX_NONE;
 
 	UPROPERTY()
 	int32 AllocatedAmount = 0;
 
-	bool operator==(const FNodeCostDefinition& Other) const { return CostDefinition == Other; }
+	bool operator==(int32 OtherResourceSlot) const { return ResourceSlot == OtherResourceSlot; }
+
+	/**
+	 * @brief Packed network serialization: the resource slot and the amount as packed integers.
+	 * @details The slot is sent as ResourceSlot + 1, so 0 stands for INDEX_NONE. The amount is zig-zag encoded, so
+	 * refunds that leave a negative total survive the round trip and small magnitudes of either sign stay small.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		uint32 PackedSlot = static_cast<uint32>(FMath::Max(ResourceSlot, INDEX_NONE) + 1);
+		uint32 PackedAmount = (static_cast<uint32>(AllocatedAmount) << 1) ^ static_cast<uint32>(AllocatedAmount >> 31);
+		Ar.SerializeIntPacked(PackedSlot);
+		Ar.SerializeIntPacked(PackedAmount);
+		if (Ar.IsLoading())
+		{
+			ResourceSlot = static_cast<int32>(PackedSlot) - 1;
+			AllocatedAmount = static_cast<int32>(PackedAmount >> 1) ^ -static_cast<int32>(PackedAmount & 1);
+		}
+
+		bOutSuccess = !Ar.IsError();
+		return true;
+	}
+
+	// ~FFastArraySerializerItem
+	void PreReplicatedRemove(const FReplicatedResourceAllocationArray& InArraySerializer);
+	void PostReplicatedAdd(const FReplicatedResourceAllocationArray& InArraySerializer);
+	void PostReplicatedChange(const FReplicatedResourceAllocationArray& InArraySerializer);
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedResourceAllocation> : public TStructOpsTypeTraitsBase2<FReplicatedResourceAllocation>
+{
+	enum { WithNetSerializer = true };
+};
+
+/**
+ * @struct FReplicatedResourceAllocationArray
+ * @brief Delta-replicated list of resource allocations. Only changed entries are sent.
+ */
+USTRUCT()
+struct FReplicatedResourceAllocationArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Finds the allocation entry for a resource.
+	 * @param InResourceSlot The manager resource slot of the resource.
+	 * @return The entry, or nullptr if nothing has been allocated for this resource yet.
+	 */
+	FReplicatedResourceAllocation* FindBySlot(int32 InResourceSlot) { return Items.FindByKey(InResourceSlot); }
+	const FReplicatedResourceAllocation* FindBySlot(int32 InResourceSlot) const { return Items.FindByKey(InResourceSlot); }
+
+	/**
+	 * @brief [Server] Sets the allocated amount for a resource and marks only that entry dirty.
+	 * @param InResourceSlot The manager resource slot of the resource.
+	 * @param NewAmount The new total allocated amount.
+	 */
+	void SetAllocatedAmount(int32 InResourceSlot, int32 NewAmount)
+	{
+		FReplicatedResourceAllocation* Entry = FindBySlot(InResourceSlot);
+		if (!Entry)
+		{
+			Entry = &Items.AddDefaulted_GetRef();
+			Entry->ResourceSlot = InResourceSlot;
+		}
+		else if (Entry->AllocatedAmount == NewAmount)
+		{
+			return;
+		}
+		Entry->AllocatedAmount = NewAmount;
+		MarkItemDirty(*Entry);
+	}
+
+	/**
+	 * @brief [Server] Moves every entry to its new resource slot after the slots were renumbered.
+	 * @details Entries whose resource no longer has a slot are removed. Only entries whose slot changed are marked dirty.
+	 * @param NewSlotByOldSlot New slot per old slot, INDEX_NONE for resources that were dropped.
+	 */
+	void RemapSlots(TConstArrayView<int32> NewSlotByOldSlot)
+	{
+		bool bRemovedAny = false;
+		for (int32 Index = Items.Num() - 1; Index >= 0; --Index)
+		{
+			FReplicatedResourceAllocation& Entry = Items[Index];
+			const int32 NewSlot = NewSlotByOldSlot.IsValidIndex(Entry.ResourceSlot) ? NewSlotByOldSlot[Entry.ResourceSlot] : INDEX_NONE;
+			if (NewSlot == INDEX_NONE)
+			{
+				Items.RemoveAtSwap(Index);
+				bRemovedAny = true;
+			}
+			else if (NewSlot != Entry.ResourceSlot)
+			{
+				Entry.ResourceSlot = NewSlot;
+				MarkItemDirty(Entry);
+			}
+		}
+		if (bRemovedAny)
+		{
+			MarkArrayDirty();
+		}
+	}
+
+	/**
+	 * @brief [Server] Removes every entry.
+	 */
+	void Reset()
+	{
+		Items.Reset();
+		MarkArrayDirty();
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FReplicatedResourceAllocation, FReplicatedResourceAllocationArray>(Items, DeltaParms, *this);
+	}
+
+	UPROPERTY()
+	TArray<FReplicatedResourceAllocation> Items;
+
+	/** @brief The manager that owns this array. Used by the per-item replication callbacks. */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UCrimsonSkillTreeManager> OwningManager = nullptr;
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedResourceAllocationArray> : public TStructOpsTypeTraitsBase2<FReplicatedResourceAllocationArray>
+{
+	enum { WithNetDeltaSerializer = true };
 };
 
 /**
  * @struct FReplicatedNodeState
  * @brief Holds the minimal replicated state for a single skill node.
+ * @details Uses a bit-packed NetSerialize: when the server knows the node's tree index (position in
+ * ConfiguredSkillTrees) and dense node index, only those two packed integers and a packed level/state word are sent.
+ * Otherwise the full GUID is sent. On the receiving side, index-addressed entries arrive with an invalid NodeGUID;
+ * PostReplicatedAdd and PostReplicatedChange fill it in on the item itself through
+ * UCrimsonSkillTreeManager::ResolveReplicatedNodeGuid before the manager applies the entry.
  */
 USTRUCT()
-struct FReplicatedNodeState
+struct FReplicatedNodeState : public FFastArraySerializerItem
 {
 	GENERATED_BODY()
 
+	/** @brief Number of low bits of the packed level/state word used for the node state. */
+	static constexpr uint32 NodeStateBits = 2;
+
 	UPROPERTY()
 	FGuid NodeGUID;
 
@@ -49,7 +196,252 @@ struct FReplicatedNodeState
 	UPROPERTY()
 	ENodeState NodeState = ENodeState::UnSet;
 
+	/** @brief Index of the owning tree in ConfiguredSkillTrees, or INDEX_NONE to replicate by GUID. */
+	int32 TreeIndex = INDEX_NONE;
+
+	/** @brief Dense index of the node in its tree's shared definition, or INDEX_NONE to replicate by GUID. */
+	int32 NodeIndex = INDEX_NONE;
+
 	bool operator==(const FGuid& OtherGuid) const { return NodeGUID == OtherGuid; }
+
+	/**
+	 * @brief Checks whether this entry is addressed by tree/node index instead of GUID.
+	 * @return True if both indices are set.
+	 */
+	bool IsIndexAddressed() const { return TreeIndex != INDEX_NONE && NodeIndex != INDEX_NONE; }
+
+	/**
+	 * @brief Bit-packed network serialization.
+	 * @details Layout: 1 bit addressing mode, then either packed TreeIndex + NodeIndex or the 128-bit GUID, then a packed
+	 * word holding (CurrentLevel << NodeStateBits) | NodeState.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+	{
+		static_assert(static_cast<uint8>(ENodeState::Suppressed) < (1 << NodeStateBits), "ENodeState no longer fits in NodeStateBits.");
+
+		uint8 bIndexAddressed = Ar.IsSaving() && IsIndexAddressed() ? 1 : 0;
+		Ar.SerializeBits(&bIndexAddressed, 1);
+
+		if (bIndexAddressed)
+		{
+			uint32 PackedTreeIndex = static_cast<uint32>(FMath::Max(TreeIndex, 0));
+			uint32 PackedNodeIndex = static_cast<uint32>(FMath::Max(NodeIndex, 0));
+			Ar.SerializeIntPacked(PackedTreeIndex);
+			Ar.SerializeIntPacked(PackedNodeIndex);
+			if (Ar.IsLoading())
+			{
+				TreeIndex = static_cast<int32>(PackedTreeIndex);
+				NodeIndex = static_cast<int32>(PackedNodeIndex);
+				NodeGUID.Invalidate();
+			}
+		}
+		else
+		{
+			Ar << NodeGUID;
+			if (Ar.IsLoading())
+			{
+				TreeIndex = INDEX_NONE;
+				NodeIndex = INDEX_NONE;
+			}
+		}
+
+		uint32 PackedLevelAndState = (static_cast<uint32>(FMath::Max(CurrentLevel, 0)) << NodeStateBits) | static_cast<uint32>(NodeState);
+		Ar.SerializeIntPacked(PackedLevelAndState);
+		if (Ar.IsLoading())
+		{
+			CurrentLevel = static_cast<int32>(PackedLevelAndState >> NodeStateBits);
+			NodeState = static_cast<ENodeState>(PackedLevelAndState & ((1u << NodeStateBits) - 1));
+		}
+
+		bOutSuccess = !Ar.IsError();
+		return true;
+	}
+
+	// ~FFastArraySerializerItem
+	void PreReplicatedRemove(const FReplicatedNodeStateArray& InArraySerializer);
+
+	/** @brief Resolves NodeGUID through ResolveAddressing, then forwards to the manager. */
+	void PostReplicatedAdd(const FReplicatedNodeStateArray& InArraySerializer);
+
+	/** @brief Resolves NodeGUID through ResolveAddressing, then forwards to the manager. */
+	void PostReplicatedChange(const FReplicatedNodeStateArray& InArraySerializer);
+
+private:
+	/**
+	 * @brief [Client] Fills in NodeGUID for an index-addressed entry.
+	 * @details Leaves NodeGUID invalid when the tree's definition hash does not match the server's, or when the hashes
+	 * or the tree's runtime instance have not arrived yet. The manager skips such entries and resolves them again in
+	 * UCrimsonSkillTreeManager::ReapplyReplicatedNodeStates; on a hash mismatch it has also asked the server to re-send
+	 * them by GUID.
+	 * @param InArraySerializer The owning array, used to reach the manager.
+	 */
+	void ResolveAddressing(const FReplicatedNodeStateArray& InArraySerializer);
+
+	friend class UCrimsonSkillTreeManager;
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedNodeState> : public TStructOpsTypeTraitsBase2<FReplicatedNodeState>
+{
+	enum { WithNetSerializer = true };
+};
+
+/**
+ * @struct FReplicatedNodeStateArray
+ * @brief Delta-replicated list of assigned node states.
+ * @details Only added, changed or removed nodes cross the wire, and the client applies each one through the per-item
+ * callbacks instead of re-applying the whole list.
+ */
+USTRUCT()
+struct FReplicatedNodeStateArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Finds the replicated state of a node.
+	 * @param InNodeGuid The GUID of the node.
+	 * @return The entry, or nullptr if the node is not replicated.
+	 */
+	FReplicatedNodeState* FindByGuid(const FGuid& InNodeGuid) { return Items.FindByKey(InNodeGuid); }
+	const FReplicatedNodeState* FindByGuid(const FGuid& InNodeGuid) const { return Items.FindByKey(InNodeGuid); }
+
+	/**
+	 * @brief [Server] Adds or updates the entry for a node and marks only that entry dirty.
+	 * @details The tree/node indices of an existing entry are refreshed as well, so an entry whose tree moved in
+	 * ConfiguredSkillTrees or whose template was rebuilt is re-sent with its current address.
+	 * @param InNodeGuid The GUID of the node.
+	 * @param InTreeIndex The index of the node's tree in ConfiguredSkillTrees, or INDEX_NONE to replicate by GUID.
+	 * @param InNodeIndex The dense index of the node, or INDEX_NONE to replicate by GUID.
+	 * @param InLevel The node's current level.
+	 * @param InState The node's current state.
+	 */
+	void AddOrUpdate(const FGuid& InNodeGuid, int32 InTreeIndex, int32 InNodeIndex, int32 InLevel, ENodeState InState)
+	{
+		const int32 TreeIndex = bReplicateByGuid ? INDEX_NONE : InTreeIndex;
+		const int32 NodeIndex = bReplicateByGuid ? INDEX_NONE : InNodeIndex;
+
+		FReplicatedNodeState* Entry = FindByGuid(InNodeGuid);
+		if (!Entry)
+		{
+			Entry = &Items.AddDefaulted_GetRef();
+			Entry->NodeGUID = InNodeGuid;
+		}
+		else if (Entry->CurrentLevel == InLevel && Entry->NodeState == InState && Entry->TreeIndex == TreeIndex && Entry->NodeIndex == NodeIndex)
+		{
+			return;
+		}
+		Entry->TreeIndex = TreeIndex;
+		Entry->NodeIndex = NodeIndex;
+		Entry->CurrentLevel = InLevel;
+		Entry->NodeState = InState;
+		MarkItemDirty(*Entry);
+	}
+
+	/**
+	 * @brief [Server] Removes the entry for a node.
+	 * @param InNodeGuid The GUID of the node.
+	 * @return True if an entry was removed.
+	 */
+	bool Remove(const FGuid& InNodeGuid)
+	{
+		const int32 Index = Items.IndexOfByKey(InNodeGuid);
+		if (Index == INDEX_NONE)
+		{
+			return false;
+		}
+		Items.RemoveAtSwap(Index);
+		MarkArrayDirty();
+		return true;
+	}
+
+	/**
+	 * @brief [Server] Removes every entry.
+	 */
+	void Reset()
+	{
+		Items.Reset();
+		MarkArrayDirty();
+	}
+
+	/**
+	 * @brief [Server] Moves every index-addressed entry to its tree's new position after ConfiguredSkillTrees changed.
+	 * @details Entries whose tree is no longer configured are removed. Only entries whose tree index changed are marked
+	 * dirty. GUID-addressed entries are left untouched.
+	 * @param NewTreeIndexByOld New tree index per old tree index, INDEX_NONE for trees that were dropped.
+	 */
+	void RemapTreeIndices(TConstArrayView<int32> NewTreeIndexByOld)
+	{
+		bool bRemovedAny = false;
+		for (int32 Index = Items.Num() - 1; Index >= 0; --Index)
+		{
+			FReplicatedNodeState& Entry = Items[Index];
+			if (!Entry.IsIndexAddressed())
+			{
+				continue;
+			}
+
+			const int32 NewTreeIndex = NewTreeIndexByOld.IsValidIndex(Entry.TreeIndex) ? NewTreeIndexByOld[Entry.TreeIndex] : INDEX_NONE;
+			if (NewTreeIndex == INDEX_NONE)
+			{
+				Items.RemoveAtSwap(Index);
+				bRemovedAny = true;
+			}
+			else if (NewTreeIndex != Entry.TreeIndex)
+			{
+				Entry.TreeIndex = NewTreeIndex;
+				MarkItemDirty(Entry);
+			}
+		}
+		if (bRemovedAny)
+		{
+			MarkArrayDirty();
+		}
+	}
+
+	/**
+	 * @brief [Server] Switches every existing and future entry to GUID addressing and re-sends them all.
+	 * @details Used when a client reports that one of its definition hashes differs from the server's.
+	 */
+	void SwitchToGuidAddressing()
+	{
+		if (bReplicateByGuid)
+		{
+			return;
+		}
+
+		bReplicateByGuid = true;
+		for (FReplicatedNodeState& Entry : Items)
+		{
+			Entry.TreeIndex = INDEX_NONE;
+			Entry.NodeIndex = INDEX_NONE;
+			MarkItemDirty(Entry);
+		}
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FReplicatedNodeState, FReplicatedNodeStateArray>(Items, DeltaParms, *this);
+	}
+
+	UPROPERTY()
+	TArray<FReplicatedNodeState> Items;
+
+	/** @brief The manager that owns this array. Used by the per-item replication callbacks. */
+	UPROPERTY(NotReplicated)
+	TObjectPtr<UCrimsonSkillTreeManager> OwningManager = nullptr;
+
+	/**
+	 * @brief [Server] If true, new entries are always addressed by GUID. Set from
+	 * UCrimsonSkillTreeManager::bReplicateNodeStatesByGuid, or by SwitchToGuidAddressing on a definition hash mismatch.
+	 */
+	UPROPERTY(NotReplicated)
+	bool bReplicateByGuid = false;
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedNodeStateArray> : public TStructOpsTypeTraitsBase2<FReplicatedNodeStateArray>
+{
+	enum { WithNetDeltaSerializer = true };
 };
 
 /**
@@ -65,6 +457,35 @@ enum class ECrimsonSkillNodeActionType : uint8
 	DecrementLevel
 };
 
+/**
+ * @struct FCrimsonSkillNodeActionRequest
+ * @brief A single (node, action) pair of a batched node action request.
+ */
+USTRUCT(BlueprintType)
+struct FCrimsonSkillNodeActionRequest
+{
+	GENERATED_BODY()
+
+	FCrimsonSkillNodeActionRequest() = default;
+	FCrimsonSkillNodeActionRequest(const FGuid& InNodeGuid, ECrimsonSkillNodeActionType InActionType, FGameplayTag InSkillTreeTypeTag = FGameplayTag())
+		: TargetNodeGuid(InNodeGuid), SkillTreeTypeTag(InSkillTreeTypeTag), ActionType(InActionType) {}
+
+	/** @brief The GUID of the node to perform the action on. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skill Tree")
+	FGuid TargetNodeGuid;
+
+	/**
+	 * @brief The tree containing the node. Optional, but required when the GUID exists in more than one configured tree
+	 * (two entries of the same asset, or a duplicated asset).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skill Tree")
+	FGameplayTag SkillTreeTypeTag;
+
+	/** @brief The action to perform. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Skill Tree")
+	ECrimsonSkillNodeActionType ActionType = ECrimsonSkillNodeActionType::IncrementLevel;
+};
+
 /**
  * @struct FCrimsonSkillTreeEntry
  * @brief Defines a skill tree asset and its corresponding type tag for configuration.
@@ -114,6 +535,8 @@ public:
 
 	/**
 	 * @brief Defines the properties that should be replicated.
+	 * @details All replicated properties are registered as push-based, so the net driver only compares them after one of
+	 * the Mark*Dirty functions has been called instead of polling them every frame.
 	 * @param OutLifetimeProps Array to which replicated properties are added.
 	 */
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
@@ -200,6 +623,9 @@ public:
 
 	/**
 	 * @brief Checks if a node's level can be safely decremented without invalidating other nodes.
+	 * @details Structural orphans (when the decrement deactivates the node) come from the tree's reachability index in
+	 * one pass. Only direct dependents are then re-checked for level- and benefit-based activation conditions. The
+	 * simulated benefits are collected into SimulationDataScratch, which is cleared first instead of reallocated.
 	 * @param NodeToDecrement The node to check.
 	 * @param OutInvalidatedNodes An array that will be populated with any nodes that would become invalid.
 	 * @return True if the decrement is safe, false otherwise.
@@ -207,10 +633,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree|Actions")
 	virtual bool CanSafelyDecrementNodeLevel(UCrimsonSkillTree_Node* NodeToDecrement, TArray<UCrimsonSkillTree_Node*>& OutInvalidatedNodes);
 
+	/**
+	 * @brief Checks whether unassigning a set of nodes (e.g. a respec preview) would leave every other active node valid.
+	 * @details Uses the bitset hypothetical API with manager-owned scratch sets and SimulationDataScratch, each cleared
+	 * at the start of the preview, so repeated previews (tooltips on hover) do not allocate.
+	 * @param NodesToUnassign The nodes to hypothetically unassign. All must belong to the same tree.
+	 * @param OutInvalidatedNodes Receives the nodes that would become invalid.
+	 * @return True if no other node would be invalidated.
+	 */
+	bool PreviewUnassignNodes(const TArray<UCrimsonSkillTree_Node*>& NodesToUnassign, TArray<UCrimsonSkillTree_Node*>& OutInvalidatedNodes);
+
 	// ~Resource Management
 	// =============================================================================================================
 	/**
 	 * @brief Gets the total budget for a specific resource type.
+	 * @details GameplayAttributeValue budgets are cached per resource slot and invalidated through the attribute watcher.
+	 * ActorIntegerProperty budgets are read live through FCrimsonSkillTree_PropertyCache, which resolves
+	 * ActorResourcePropertyName once per owner class and then reads the int32 directly at the cached offset. They are
+	 * only cached when bCachePropertyBackedBudgets is set, in which case the project must call
+	 * NotifyResourcePropertyChanged.
 	 * @param InCostDefinition The definition of the resource.
 	 * @param OutTotalBudget The total available amount of the resource.
 	 * @return True if the budget was successfully retrieved, false otherwise.
@@ -225,6 +666,30 @@ public:
 	 */
 	bool GetOverallAllocatedAmountForResource(const FNodeCostDefinition& InCostDefinition, int32& OutAllocatedAmount) const;
 
+	/**
+	 * @brief Gets the manager resource slot of a resource.
+	 * @details Slots are assigned by RebuildResourceSlots and index AllocatedAmountBySlot and the replicated allocations.
+	 * @param InCostDefinition The definition of the resource.
+	 * @return The slot, or INDEX_NONE if no configured skill tree uses this resource.
+	 */
+	int32 GetResourceSlot(const FNodeCostDefinition& InCostDefinition) const;
+
+	/**
+	 * @brief Gets the manager resource slot of an interned resource.
+	 * @param ResourceId The ResourceId from FCrimsonSkillTree_ResourceRegistry.
+	 * @return The slot, or INDEX_NONE if no configured skill tree uses this resource.
+	 */
+	int32 GetResourceSlotById(int32 ResourceId) const { return SlotByResourceId.IsValidIndex(ResourceId) ? SlotByResourceId[ResourceId] : INDEX_NONE; }
+
+	/** @brief Gets the manager resource slot per ResourceId, for compiled condition evaluation. */
+	TConstArrayView<int32> GetSlotByResourceId() const { return SlotByResourceId; }
+
+	/** @brief Gets the allocated amount per manager resource slot, for compiled condition evaluation. */
+	TConstArrayView<int32> GetAllocatedAmountBySlot() const { return AllocatedAmountBySlot; }
+
+	/** @brief Gets the shared attribute-change fan-out used by AttributeRequirement conditions. */
+	FCrimsonSkillTree_AttributeWatcher& GetAttributeWatcher() { return AttributeWatcher; }
+
 	/**
 	 * @brief Gets the current available value of a resource (Total - Allocated).
 	 * @param InCostDefinition The definition of the resource.
@@ -251,6 +716,81 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree|UI")
 	void GetResourceUIData(const FNodeCostDefinition& ForCostDefinition, int32& OutUsedAmount, int32& OutTotalAmount, FText& OutResourceName);
 
+	/**
+	 * @brief Invalidates the cached budget of every resource backed by an actor integer property.
+	 * @details Only needed when bCachePropertyBackedBudgets is set. Call it after changing the property, e.g. from the
+	 * setter or OnRep of a "SkillPoints" variable. Attribute-backed budgets do not need this; they are invalidated
+	 * through the attribute watcher.
+	 * @param PropertyName The name of the changed property. NAME_None invalidates every property-backed budget.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Skill Tree|Resources")
+	void NotifyResourcePropertyChanged(FName PropertyName);
+
+	/**
+	 * @brief Checks whether the current available value of a resource covers an amount. O(1) while the budget cache is clean.
+	 * @param ResourceSlot The manager resource slot.
+	 * @param Amount The amount to check.
+	 * @return True if the resource can pay for Amount.
+	 */
+	bool CanAffordResourceSlot(int32 ResourceSlot, int32 Amount);
+
+	// ~Bulk Apply
+	// =============================================================================================================
+	/**
+	 * @brief Opens a bulk-apply transaction. Prefer FCrimsonSkillTreeBulkApplyScope over calling this directly.
+	 * @details While a transaction is open, node state changes only record what needs to happen afterwards:
+	 * OnSkillTreeStateUpdated/OnSkillTreeModifyResourceCost broadcasts, push-model dirty marks, condition monitoring
+	 * changes, dirty-node evaluation and saves. Transactions nest; the outermost EndBulkApply performs the work once.
+	 */
+	void BeginBulkApply();
+
+	/**
+	 * @brief Closes a bulk-apply transaction. The outermost call flushes every deferred operation, in this order:
+	 * coalesced node events, dirty nodes (topological), condition monitoring, allocated resource cache, replication,
+	 * broadcasts, saves.
+	 */
+	void EndBulkApply();
+
+	/**
+	 * @brief Routes a node's level-changed events through the event coalescer while a transaction is open.
+	 * @param Node The node whose level changed.
+	 * @param OldLevel The level before the change.
+	 * @param NewLevel The level after the change.
+	 * @return True if the events were deferred; false if the caller should execute them now.
+	 */
+	bool DeferLevelChangedEvents(UCrimsonSkillTree_Node* Node, int32 OldLevel, int32 NewLevel);
+
+	/**
+	 * @brief Routes a node's reset events through the event coalescer while a transaction is open.
+	 * @param Node The node being reset.
+	 * @param PreviousLevel The level before the reset.
+	 * @return True if the events were deferred; false if the caller should execute them now.
+	 */
+	bool DeferNodeResetEvents(UCrimsonSkillTree_Node* Node, int32 PreviousLevel);
+
+	/** @brief Checks whether a bulk-apply transaction is open. */
+	bool IsInBulkApply() const { return BulkApplyDepth > 0; }
+
+	/**
+	 * @brief Defers a tree save until the current transaction ends. Saves immediately outside a transaction.
+	 * @param SkillTree The tree to save.
+	 */
+	void RequestSaveSkillTreeState(UCrimsonSkillTree* SkillTree);
+
+	/**
+	 * @brief Defers a node's condition monitoring change until the current transaction ends. Applies immediately outside a transaction.
+	 * @details Only the final monitoring state of each node is applied, so a node that is deactivated and reactivated
+	 * during a load never unbinds and rebinds its conditions.
+	 * @param Node The node.
+	 * @param bShouldMonitor The desired monitoring state.
+	 */
+	void RequestConditionMonitoring(UCrimsonSkillTree_Node* Node, bool bShouldMonitor);
+
+	/**
+	 * @brief Defers OnSkillTreeStateUpdated and the replication dirty marks until the current transaction ends. Applies immediately outside a transaction.
+	 */
+	void RequestStateUpdatedBroadcast();
+
 	// ~Save & Load
 	// =============================================================================================================
 	/**
@@ -262,6 +802,8 @@ public:
 
 	/**
 	 * @brief Loads the state of a single skill tree from the save game slot.
+	 * @details Runs inside an FCrimsonSkillTreeBulkApplyScope: nodes are restored in topological order with broadcasts,
+	 * replication updates, condition monitoring and saves deferred, then one consolidated update is emitted.
 	 * @param SkillTreeToLoad The skill tree instance to load state into.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree|SaveGame")
@@ -277,6 +819,7 @@ public:
 	// =============================================================================================================
 	/**
 	 * @brief Traverses a list of skill trees and executes an action on each node.
+	 * @details Nodes are visited in dense index order of each tree's state block.
 	 * @param TreesToTraverse The array of skill trees to traverse.
 	 * @param NodeAction The action to execute on each node.
 	 */
@@ -285,8 +828,12 @@ public:
 
 	// ~Server RPCs
 	// =============================================================================================================
+	// Every server action below runs inside an FCrimsonSkillTreeBulkApplyScope. Its EndBulkApply flushes the dirty queue
+	// synchronously before replicating, so the state a client receives already includes every cascaded re-evaluation.
+
 	/**
 	 * @brief [Server] Requests a specific action (e.g., activate, level up) to be performed on a skill node.
+	 * @details Runs inside an FCrimsonSkillTreeBulkApplyScope, so dirty nodes are flushed before the action returns.
 	 * @param TargetNodeGuid The GUID of the node to perform the action on.
 	 * @param ActionType The type of action to perform.
 	 */
@@ -294,9 +841,49 @@ public:
 	void Server_RequestSkillNodeAction(const FGuid& TargetNodeGuid, ECrimsonSkillNodeActionType ActionType);
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree|Utility")
 	void Client_RequestSkillNodeAction(const FGuid& TargetNodeGuid, ECrimsonSkillNodeActionType ActionType);
+
+	/**
+	 * @brief [Server] Same as Server_RequestSkillNodeAction, but resolves the node inside one tree.
+	 * @details Use this when the node's GUID exists in more than one configured tree; Server_RequestSkillNodeAction
+	 * rejects such GUIDs as ambiguous.
+	 * @param SkillTreeTypeTag The tag of the tree containing the node.
+	 * @param TargetNodeGuid The GUID of the node to perform the action on.
+	 * @param ActionType The type of action to perform.
+	 */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Server_RequestSkillNodeActionInTree(FGameplayTag SkillTreeTypeTag, const FGuid& TargetNodeGuid, ECrimsonSkillNodeActionType ActionType);
+	UFUNCTION(BlueprintCallable, Category = "Skill Tree|Utility")
+	void Client_RequestSkillNodeActionInTree(FGameplayTag SkillTreeTypeTag, const FGuid& TargetNodeGuid, ECrimsonSkillNodeActionType ActionType);
+
+	/**
+	 * @brief [Server] Requests an ordered list of node actions to be applied atomically.
+	 * @details Every action is validated against the node levels, states and allocated resources produced by the
+	 * actions before it, including the states their changes cascaded into descendants. Node events are the exception:
+	 * they run only after the whole batch succeeded, so an action never sees attributes, tags or other effects granted
+	 * by the events of earlier actions in the same batch. If any action fails, the whole batch is rolled back: node
+	 * levels and states of every touched tree (including cascaded descendants), allocated resources and pending
+	 * condition monitoring are restored, and no node event executes. On success, OnSkillTreeStateUpdated, replication and the optional autosave each
+	 * happen once for the whole batch.
+	 * @param Requests The ordered (node, action) pairs. Limited to MaxNodeActionBatchSize entries.
+	 */
+	UFUNCTION(Server, Reliable, WithValidation)
+	void Server_RequestSkillNodeActionBatch(const TArray<FCrimsonSkillNodeActionRequest>& Requests);
+
+	/**
+	 * @brief Sends a batched node action request to the server, e.g. from a planner UI that buys several nodes at once.
+	 * @param Requests The ordered (node, action) pairs.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Skill Tree|Utility")
+	void Client_RequestSkillNodeActionBatch(const TArray<FCrimsonSkillNodeActionRequest>& Requests);
+
+	/** @brief Maximum number of entries accepted by Server_RequestSkillNodeActionBatch. Larger batches fail validation. */
+	static constexpr int32 MaxNodeActionBatchSize = 256;
 	
 	/**
 	 * @brief [Server] Forces all nodes in a specific skill tree to be unassigned (a "respec").
+	 * @details The refund is computed with FCrimsonSkillTree_SharedDefinition::AccumulateSpentPerResource before the levels are reset.
+	 * Runs inside an FCrimsonSkillTreeBulkApplyScope, so the reset events are coalesced per node and the whole respec
+	 * produces one broadcast, one replication update and one save.
 	 * @param SkillTreeTypeTag The tag identifying the skill tree to respec.
 	 */
 	UFUNCTION(BlueprintCallable, Server, Reliable, Category = "Skill Tree|Admin", meta = (DisplayName = "Force Respec Skill Tree (Unassign All Nodes)"))
@@ -304,6 +891,7 @@ public:
 
 	/**
 	 * @brief [Server] Forces a single node to be unlocked.
+	 * @details Runs inside an FCrimsonSkillTreeBulkApplyScope, so stepping to max level fires the node's events once.
 	 * @param SkillTreeTypeTag The tag of the tree containing the node.
 	 * @param NodeName The display name of the node to unlock.
 	 * @param bUnlockToMaxLevel If true, unlocks the node to its maximum level.
@@ -313,6 +901,7 @@ public:
 
 	/**
 	 * @brief [Server] Forces a node and all of its descendants to be unlocked.
+	 * @details Runs inside a single FCrimsonSkillTreeBulkApplyScope for the whole subtree.
 	 * @param SkillTreeTypeTag The tag of the tree containing the node.
 	 * @param NodeName The display name of the starting node.
 	 * @param bUnlockToMaxLevel If true, unlocks all affected nodes to their maximum level.
@@ -322,6 +911,7 @@ public:
 
 	/**
 	 * @brief [Server] Forces a node and its descendants up to a specific depth to be unlocked.
+	 * @details Runs inside a single FCrimsonSkillTreeBulkApplyScope for every unlocked node.
 	 * @param SkillTreeTypeTag The tag of the tree containing the node.
 	 * @param NodeName The display name of the starting node.
 	 * @param Depth The maximum depth of descendants to unlock (-1 for infinite).
@@ -344,6 +934,26 @@ public:
 	 */
 	void Server_RemoveReplicatedNodeState(const UCrimsonSkillTree_Node* Node);
 
+	// ~Push Model & Dormancy
+	// =============================================================================================================
+	/**
+	 * @brief [Server] Marks ReplicatedNodeStates dirty for push-model replication and wakes the owner if dormant.
+	 * @details Must be called after every native write to ReplicatedNodeStates.
+	 */
+	void MarkReplicatedNodeStatesDirty();
+
+	/**
+	 * @brief [Server] Marks ReplicatedAllocatedResources dirty for push-model replication and wakes the owner if dormant.
+	 * @details Must be called after every native write to ReplicatedAllocatedResources.
+	 */
+	void MarkReplicatedAllocatedResourcesDirty();
+
+	/**
+	 * @brief [Server] Marks ConfiguredSkillTrees dirty for push-model replication and wakes the owner if dormant.
+	 * @details Must be called after every native write to ConfiguredSkillTrees. Blueprint assignments are marked dirty by the engine.
+	 */
+	void MarkConfiguredSkillTreesDirty();
+
 	/**
 	 * @brief Relays a node failure message from the server to the owning client via an RPC.
 	 * @param Message The UI message payload to be sent.
@@ -402,6 +1012,34 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Skill Trees|Save Game")
 	bool bLoadAllSkillTreesPostInitialize = true;
 
+	// ~Replication
+	// =============================================================================================================
+	/**
+	 * @brief If true, replicated node states are always addressed by their full GUID instead of packed tree/node indices.
+	 * @details Not needed for asset mismatches: the server replicates each tree's definition hash, and a client whose
+	 * hashes differ asks the server to switch to GUID addressing on its own. Enable this only to skip that round trip,
+	 * e.g. when mismatched builds are expected during a rolling patch.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Skill Trees|Replication")
+	bool bReplicateNodeStatesByGuid = false;
+
+	/**
+	 * @brief If true, the server puts the owning actor into DORM_DormantAll once initialization has replicated, and only
+	 * flushes dormancy when skill tree state changes.
+	 * @details Only enable this when the owner has no other frequently replicating state (e.g. a dedicated PlayerState
+	 * or progression actor), since dormancy applies to the whole actor.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Skill Trees|Replication")
+	bool bUseOwnerNetDormancy = false;
+
+	/**
+	 * @brief If true, budgets backed by an actor integer property are cached like attribute-backed ones.
+	 * @details The manager cannot observe plain properties, so only enable this when every write to those properties is
+	 * followed by NotifyResourcePropertyChanged. Otherwise they are read live, which is a single int32 load.
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Skill Trees|Resources")
+	bool bCachePropertyBackedBudgets = false;
+
 	/**
 	 * @brief The name of the save game slot to use.
 	 */
@@ -437,15 +1075,23 @@ protected:
 
 	/**
 	 * @brief [Client] Creates local runtime instances of all configured skill trees on the client.
+	 * @details Finishes with ReapplyReplicatedNodeStates, so node states that replicated before the instances existed
+	 * are applied.
 	 */
 	void Client_InitializeSkillTreeInstances();
 
 	/**
-	 * @brief Creates a deep-copy runtime instance of a skill tree asset.
+	 * @brief Creates a runtime instance of a skill tree asset.
+	 * @details Nothing is duplicated. The instance and one node per template node are created with NewObject, and
+	 * each node is initialized through UCrimsonSkillTree_Node::InitializeFromTemplate, which copies identity only.
+	 * Parent and child links are rebuilt from the shared definition's adjacency. Costs, display data, compiled
+	 * conditions and the event and condition objects stay on the template, and per-actor event and condition
+	 * instances are only created for nodes that execute or monitor them. The shared definition is taken from
+	 * UCrimsonSkillTree::EnsureSharedDefinition, which only builds it for templates that were never loaded.
 	 * @param InSkillTree The skill tree asset to instance.
 	 * @return A new runtime instance of the skill tree.
 	 */
-	virtual UCrimsonSkillTree* CreateSkillTreeRuntimeInstance(const UCrimsonSkillTree* InSkillTree);
+	virtual UCrimsonSkillTree* CreateSkillTreeRuntimeInstance(UCrimsonSkillTree* InSkillTree);
 
 
 	/**
@@ -462,11 +1108,97 @@ protected:
 	// ~Replication
 	// =============================================================================================================
 	/**
-	 * @brief [Client] Called when the ReplicatedNodeStates array is updated.
+	 * @brief [Client] Called once after a ReplicatedNodeStates delta has been applied.
+	 * @details Individual nodes have already been updated by HandleReplicatedNodeStateChanged; this only broadcasts
+	 * OnSkillTreeStateUpdated.
 	 */
 	UFUNCTION()
 	void OnRep_ReplicatedNodeStates();
 
+	/**
+	 * @brief [Client] Applies a single added or changed replicated node state to the matching local node.
+	 * @details The entry's NodeGUID has already been resolved by the item's PostReplicatedAdd/PostReplicatedChange.
+	 * Entries that could not be resolved (invalid NodeGUID) or whose node does not exist locally yet are skipped here
+	 * and applied later by ReapplyReplicatedNodeStates.
+	 * @param ReplicatedState The entry that was added or changed.
+	 */
+	void HandleReplicatedNodeStateChanged(const FReplicatedNodeState& ReplicatedState);
+
+	/**
+	 * @brief [Client] Applies replicated entries again after data they depend on has arrived.
+	 * @details Called from OnRep_ReplicatedDefinitionHashes with bUnresolvedOnly set, for index-addressed entries that
+	 * arrived before the hashes, and at the end of Client_InitializeSkillTreeInstances for every entry, since entries
+	 * received before the runtime instances existed had no node to apply to.
+	 * @param bUnresolvedOnly If true, only entries whose NodeGUID is still invalid are re-applied.
+	 */
+	void ReapplyReplicatedNodeStates(bool bUnresolvedOnly)
+	{
+		for (FReplicatedNodeState& ReplicatedState : ReplicatedNodeStates.Items)
+		{
+			if (bUnresolvedOnly && ReplicatedState.NodeGUID.IsValid())
+			{
+				continue;
+			}
+			if (ReplicatedState.IsIndexAddressed())
+			{
+				ReplicatedState.ResolveAddressing(ReplicatedNodeStates);
+			}
+			HandleReplicatedNodeStateChanged(ReplicatedState);
+		}
+	}
+
+	/**
+	 * @brief [Client] Called when the server's definition hashes arrive. Re-applies index-addressed entries that could
+	 * not be resolved without them.
+	 */
+	UFUNCTION()
+	void OnRep_ReplicatedDefinitionHashes() { ReapplyReplicatedNodeStates(true); }
+
+	/**
+	 * @brief [Client] Maps a replicated tree/node index pair to the node GUID.
+	 * @details Fails when the tree's local definition hash differs from ReplicatedDefinitionHashes, or when the server's
+	 * hashes have not arrived yet. The first mismatch calls Server_RequestGuidAddressedNodeStates.
+	 * @param TreeIndex Index of the tree in ConfiguredSkillTrees.
+	 * @param NodeIndex Dense node index in that tree's shared definition.
+	 * @param OutNodeGuid Receives the GUID on success.
+	 * @return True if the indices were resolved.
+	 */
+	bool ResolveReplicatedNodeGuid(int32 TreeIndex, int32 NodeIndex, FGuid& OutNodeGuid);
+
+	/**
+	 * @brief [Server] Called by a client whose definition hashes differ from the server's. Switches ReplicatedNodeStates
+	 * to GUID addressing, which re-sends every entry.
+	 */
+	UFUNCTION(Server, Reliable)
+	void Server_RequestGuidAddressedNodeStates();
+
+	/**
+	 * @brief [Server] Fills ReplicatedDefinitionHashes from the shared definition of every configured tree.
+	 * @details Called whenever the server (re)creates its runtime instances. When ConfiguredSkillTrees changed since the
+	 * last call, existing ReplicatedNodeStates entries are first moved to their tree's new index with
+	 * FReplicatedNodeStateArray::RemapTreeIndices, matching trees through ReplicatedTreeTypeTags.
+	 */
+	void UpdateReplicatedDefinitionHashes();
+
+	/**
+	 * @brief Resolves the local node targeted by a replicated node state, by tree/node index or by GUID.
+	 * @param ReplicatedState The replicated entry.
+	 * @return The local node, or nullptr if it cannot be resolved.
+	 */
+	UCrimsonSkillTree_Node* ResolveReplicatedNode(const FReplicatedNodeState& ReplicatedState) const;
+
+	/**
+	 * @brief [Client] Resets the matching local node when its replicated state is removed.
+	 * @param ReplicatedState The entry that is about to be removed.
+	 */
+	void HandleReplicatedNodeStateRemoved(const FReplicatedNodeState& ReplicatedState);
+
+	/**
+	 * @brief [Client] Called for each added, changed or removed resource allocation entry.
+	 * @param ReplicatedAllocation The entry that changed.
+	 */
+	void HandleReplicatedAllocationChanged(const FReplicatedResourceAllocation& ReplicatedAllocation);
+
 	/**
  	* @brief [Client] Called when the ConfiguredSkillTrees array is replicated. Triggers client-side initialization.
  	*/
@@ -480,6 +1212,16 @@ protected:
 	void OnRep_AllocatedResourcesChanged();
 
 	
+	/**
+	 * @brief [Server] Flushes the owner's net dormancy so pending push-model changes are sent. No-op unless bUseOwnerNetDormancy is set.
+	 */
+	void WakeOwnerForReplication() const;
+
+	/**
+	 * @brief [Server] Puts the owner into DORM_DormantAll. No-op unless bUseOwnerNetDormancy is set.
+	 */
+	void EnterOwnerNetDormancy() const;
+
 	// ~Messaging
 	// =============================================================================================================
 	/**
@@ -499,12 +1241,50 @@ protected:
 	virtual const UCrimsonSkillTree* GetSkillTreeByGUID(FGuid InGuid) const;
 
 	/**
-	 * @brief Finds a node within any managed skill tree by its unique GUID.
+	 * @brief Finds a node within any managed skill tree by its GUID.
+	 * @details Resolves through NodesByGuid in O(1) instead of scanning every active tree instance. Node GUIDs are only
+	 * unique within one asset, so a GUID that exists in several active trees (the same asset configured twice, or a
+	 * duplicated asset) is ambiguous: this logs a warning and returns nullptr. Use FindNodeInTreeByGuid for those.
 	 * @param NodeGuid The GUID of the node to find.
-	 * @return The found node, or nullptr.
+	 * @return The found node, or nullptr if no tree or more than one tree contains it.
 	 */
 	UCrimsonSkillTree_Node* FindNodeByGuid(const FGuid& NodeGuid) const;
 
+	/**
+	 * @brief Finds a node within one skill tree by its GUID, through that tree's own NodeGuidLookup.
+	 * @param SkillTree The runtime tree instance to search.
+	 * @param NodeGuid The GUID of the node to find.
+	 * @return The found node, or nullptr.
+	 */
+	UCrimsonSkillTree_Node* FindNodeInTreeByGuid(const UCrimsonSkillTree* SkillTree, const FGuid& NodeGuid) const { return SkillTree ? SkillTree->FindNodeByGUID(NodeGuid) : nullptr; }
+
+	/**
+	 * @brief Resolves the target of a node action request.
+	 * @details With a valid SkillTreeTypeTag the node is looked up in that tree only; otherwise through FindNodeByGuid,
+	 * which rejects ambiguous GUIDs.
+	 * @param SkillTreeTypeTag The tag of the tree containing the node, or an empty tag.
+	 * @param NodeGuid The GUID of the node.
+	 * @return The node, or nullptr.
+	 */
+	UCrimsonSkillTree_Node* ResolveRequestedNode(FGameplayTag SkillTreeTypeTag, const FGuid& NodeGuid) const
+	{
+		return SkillTreeTypeTag.IsValid() ? FindNodeInTreeByGuid(GetSkillTree(SkillTreeTypeTag), NodeGuid) : FindNodeByGuid(NodeGuid);
+	}
+
+	/**
+	 * @brief Adds every node of a runtime tree instance to the manager-wide GUID lookup.
+	 * @details Called once per instance from CreateSkillTreeRuntimeInstance, after the tree has built its own lookup.
+	 * @param SkillTreeInstance The runtime instance whose nodes should become resolvable by GUID.
+	 */
+	void RegisterNodesForGuidLookup(const UCrimsonSkillTree* SkillTreeInstance);
+
+	/**
+	 * @brief Removes every node of a runtime tree instance from the manager-wide GUID lookup.
+	 * @details Called from ShutDownSkillTree and ClearSkillTreeState so no stale node can be resolved after shutdown.
+	 * @param SkillTreeInstance The runtime instance whose nodes should no longer be resolvable.
+	 */
+	void UnregisterNodesFromGuidLookup(const UCrimsonSkillTree* SkillTreeInstance);
+
 	/**
 	 * @brief Finds a node within a specific skill tree by its display name.
 	 * @param SkillTree The skill tree to search within.
@@ -513,6 +1293,101 @@ protected:
 	 */
 	UCrimsonSkillTree_Node* FindNodeInTreeByName(const UCrimsonSkillTree* SkillTree, FText NodeName) const;
 
+	/**
+	 * @brief [Server] Applies a single node action without broadcasting, replicating or saving.
+	 * @details Shared by Server_RequestSkillNodeAction and Server_RequestSkillNodeActionBatch.
+	 * @param TargetNode The node to act on.
+	 * @param ActionType The action to perform.
+	 * @return True if the action was applied.
+	 */
+	bool ApplyNodeActionWithoutNotify(UCrimsonSkillTree_Node* TargetNode, ECrimsonSkillNodeActionType ActionType);
+
+	/**
+	 * @brief Everything ApplyNodeActionBatch restores when an action fails.
+	 * @details Whole state blocks are copied rather than the targeted nodes only, since deactivating or unassigning a
+	 * node cascades into descendants the request never named. The event coalescer and pending monitoring are copied
+	 * as well, so a rolled back batch leaves no events or monitoring changes behind for EndBulkApply.
+	 */
+	struct FNodeActionBatchSnapshot
+	{
+		struct FTreeStates
+		{
+			TWeakObjectPtr<UCrimsonSkillTree> Tree;
+			TArray<int32> Levels;
+			TArray<ENodeState> States;
+		};
+
+		/** @brief Block copy per tree, taken the first time the batch touches the tree. */
+		TArray<FTreeStates> Trees;
+
+		TArray<int32> AllocatedAmountBySlot;
+		FCrimsonSkillTree_EventCoalescer EventCoalescer;
+		TMap<TWeakObjectPtr<UCrimsonSkillTree_Node>, bool> PendingMonitoring;
+	};
+
+	/**
+	 * @brief [Server] Applies a batch of node actions with all-or-nothing semantics.
+	 * @details Runs inside an FCrimsonSkillTreeBulkApplyScope, so every node event goes through the event coalescer and
+	 * nothing executes before the batch is committed. Calls FlushPendingDirtyNodes after every action, so the next
+	 * action is validated against cascaded node states rather than the states of the nodes it named directly; the
+	 * flush only re-evaluates states, while the events it produces stay in the coalescer. Captures an FNodeActionBatchSnapshot (the block of each tree the
+	 * first time an action touches it) and restores it with RestoreNodeActionBatchSnapshot if any action fails. Each
+	 * request's node is resolved with ResolveRequestedNode, so entries with an ambiguous GUID and no tree tag fail.
+	 * @param Requests The ordered (node, action) pairs.
+	 * @param OutTouchedTrees The trees that were modified, used for the single save afterwards.
+	 * @return True if every action was applied.
+	 */
+	bool ApplyNodeActionBatch(const TArray<FCrimsonSkillNodeActionRequest>& Requests, TArray<UCrimsonSkillTree*>& OutTouchedTrees);
+
+	/**
+	 * @brief [Server] Rolls a failed batch back to its snapshot.
+	 * @details Writes the snapshot levels and states back to the node objects and their blocks without executing any
+	 * event, then restores AllocatedAmountBySlot, the event coalescer and the pending monitoring. Nodes whose
+	 * replicated entry changed are re-marked dirty so ReplicatedNodeStates matches the restored state.
+	 * @param Snapshot The snapshot taken by ApplyNodeActionBatch.
+	 */
+	void RestoreNodeActionBatchSnapshot(FNodeActionBatchSnapshot& Snapshot);
+
+	/**
+	 * @brief Sizes the budget cache to the current resource slots, marks every entry dirty and registers every
+	 * attribute-backed resource with AttributeWatcher::AddBudgetWatcher, so an attribute watched by both conditions and
+	 * budgets is subscribed once. Called at the end of RebuildResourceSlots.
+	 */
+	void BindBudgetInvalidation();
+
+	/**
+	 * @brief Removes every budget registration made by BindBudgetInvalidation through AttributeWatcher::RemoveAllBudgetWatchers.
+	 */
+	void UnbindBudgetInvalidation();
+
+	/**
+	 * @brief Marks the cached budget of one resource slot dirty.
+	 * @param ResourceSlot The manager resource slot.
+	 */
+	void InvalidateResourceBudget(int32 ResourceSlot) { if (BudgetDirtyBySlot.IsValidIndex(ResourceSlot)) { BudgetDirtyBySlot[ResourceSlot] = true; } }
+
+	/**
+	 * @brief Bound to AttributeWatcher.OnBudgetAttributeChanged. Invalidates the budget of the slot.
+	 * @param ResourceSlot The manager resource slot whose attribute changed.
+	 */
+	void HandleBudgetAttributeChanged(int32 ResourceSlot) { InvalidateResourceBudget(ResourceSlot); }
+
+	/**
+	 * @brief Records that a tree has dirty nodes to flush.
+	 * @details Inside a transaction (every server action opens one) the tree is only recorded, and the outermost
+	 * EndBulkApply flushes it synchronously. Outside a transaction, e.g. for condition changes driven by attribute
+	 * updates rather than by an action, a next-tick timer is scheduled as a fallback. Repeated requests coalesce.
+	 * @param SkillTree The tree with dirty nodes.
+	 */
+	void RequestDirtyNodeFlush(UCrimsonSkillTree* SkillTree);
+
+	/**
+	 * @brief Flushes the dirty queue of every tree that requested it and clears the fallback timer.
+	 * @details Called by the outermost EndBulkApply, by ApplyNodeActionBatch between actions, and by the fallback timer
+	 * for changes made outside a transaction.
+	 */
+	void FlushPendingDirtyNodes();
+
 	/**
 	 * @brief [Server] Modifies the overall allocated amount for a resource.
 	 * @param InCostDefinition The definition of the resource.
@@ -523,11 +1398,26 @@ protected:
 
 	/**
 	 * @brief [Server] Recalculates and rebuilds the cache of all allocated resources.
+	 * @details Runs FCrimsonSkillTree_SharedDefinition::AccumulateSpentPerResource over each tree's level array into a
+	 * reused per-resource scratch buffer, then maps the tree's resource IDs onto manager resource slots.
 	 */
 	void RebuildAllocatedResourceCache();
 
+	/**
+	 * @brief Assigns a manager resource slot to every resource used by the configured skill trees.
+	 * @details Walks ConfiguredSkillTrees in order and each tree's shared definition resources in order, so the server
+	 * and every client derive the same slot numbering from the same replicated configuration. Called whenever
+	 * ConfiguredSkillTrees changes, on the server during initialization and on clients from OnRep_ConfiguredSkillTrees.
+	 * Existing data is carried over by ResourceId: AllocatedAmountBySlot and the budget cache move to the new slots,
+	 * and on the server ReplicatedAllocatedResources is rewritten through FReplicatedResourceAllocationArray::RemapSlots.
+	 * Clients rebuild AllocatedAmountBySlot from ReplicatedAllocatedResources instead of remapping their mirror, since
+	 * the entries they hold may already use the server's new numbering.
+	 */
+	void RebuildResourceSlots();
+
 	/**
 	 * @brief [Server] Refunds resource points from a save file that is from an older, incompatible version of a skill tree.
+	 * @details Saved levels are priced through the shared definition's FNodeCostTable prefix sums, so each node's refund is a single read per resource.
 	 * @param SkillTree The new skill tree asset.
 	 * @param InvalidatedSaveData The save data from the old version.
 	 */
@@ -563,17 +1453,136 @@ protected:
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UCrimsonSkillTree>> ActiveSkillTreeInstances;
 
+	/**
+	 * @brief Manager-wide GUID to node index spanning all ActiveSkillTreeInstances.
+	 * @details Kept in sync with ActiveSkillTreeInstances by RegisterNodesForGuidLookup and UnregisterNodesFromGuidLookup,
+	 * so RPC and OnRep handlers resolve their target node without walking every tree. Every node with the GUID is kept,
+	 * one per tree, so registering a second instance of an asset no longer overwrites the first one's entries; lookups
+	 * scoped to a tree go through that tree's own NodeGuidLookup instead. The nodes are owned by ActiveSkillTreeInstances.
+	 */
+	TMap<FGuid, TArray<UCrimsonSkillTree_Node*, TInlineAllocator<1>>> NodesByGuid;
+
+	/** @brief Reused scratch set of hypothetically inactive nodes for CanSafelyDecrementNodeLevel and PreviewUnassignNodes. */
+	FCrimsonSkillTree_NodeBitset HypotheticallyInactiveScratch;
+
+	/** @brief Reused scratch set of hypothetically altered nodes for CanSafelyDecrementNodeLevel and PreviewUnassignNodes. */
+	FCrimsonSkillTree_NodeBitset HypotheticallyAlteredScratch;
+
+	/**
+	 * @brief Reused simulation data for CanSafelyDecrementNodeLevel and PreviewUnassignNodes. Cleared at the start of
+	 * each preview; Clear keeps the chunk memory, so it stops allocating once it has held the largest preview.
+	 */
+	FSimulationDataCollector SimulationDataScratch;
+
+	/** @brief Reused per-resource-slot totals for RebuildAllocatedResourceCache and respec refunds. */
+	TArray<int32> ResourceTotalsScratch;
+
+	// ~Resource Slots
+	// =============================================================================================================
+	/** @brief ResourceId (FCrimsonSkillTree_ResourceRegistry) per manager resource slot. */
+	TArray<int32> ResourceIdBySlot;
+
+	/** @brief Manager resource slot per ResourceId, INDEX_NONE for resources no configured tree uses. */
+	TArray<int32> SlotByResourceId;
+
+	/** @brief Allocated amount per manager resource slot. Authoritative on the server, mirrored from ReplicatedAllocatedResources on clients. */
+	TArray<int32> AllocatedAmountBySlot;
+
+	// ~Budget Cache
+	// =============================================================================================================
+	/** @brief Last read total budget per manager resource slot. Valid only where BudgetDirtyBySlot is false. */
+	TArray<int32> CachedBudgetBySlot;
+
+	/** @brief Per-slot dirty flag for CachedBudgetBySlot. Property-backed slots stay dirty unless bCachePropertyBackedBudgets is set. */
+	TBitArray<> BudgetDirtyBySlot;
+
+	// ~Bulk Apply State
+	// =============================================================================================================
+	/** @brief Nesting depth of open bulk-apply transactions. */
+	int32 BulkApplyDepth = 0;
+
+	/** @brief Set when a state broadcast and replication update were requested during the transaction. */
+	bool bBulkApplyStateUpdatePending = false;
+
+	/** @brief Net level transition per node, executed when the transaction ends. */
+	FCrimsonSkillTree_EventCoalescer EventCoalescer;
+
+	/** @brief Trees to save when the transaction ends. */
+	TArray<TWeakObjectPtr<UCrimsonSkillTree>> BulkApplyPendingSaves;
+
+	/** @brief Final requested monitoring state per node, applied when the transaction ends. */
+	TMap<TWeakObjectPtr<UCrimsonSkillTree_Node>, bool> BulkApplyPendingMonitoring;
+
+	/** @brief Trees that requested a dirty-node flush since the last one ran. */
+	TArray<TWeakObjectPtr<UCrimsonSkillTree>> PendingDirtyFlushTrees;
+
+	/** @brief Fallback next-tick timer for FlushPendingDirtyNodes. Only set by requests made outside a transaction. */
+	FTimerHandle DirtyFlushTimerHandle;
+
+	/** @brief One ASC subscription per distinct attribute watched by AttributeRequirement conditions or resource budgets. Reset in ClearSkillTreeState. */
+	FCrimsonSkillTree_AttributeWatcher AttributeWatcher;
+
 	// ~Replicated State
 	// =============================================================================================================
 	/**
-	 * @brief Replicated array holding the minimal state data for all assigned nodes.
+	 * @brief Definition hash of each entry in ConfiguredSkillTrees, as built on the server.
+	 * @details Declared before ReplicatedNodeStates so it is received first. Clients compare it with their own
+	 * definitions before trusting index-addressed node states.
+	 */
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_ReplicatedDefinitionHashes)
+	TArray<uint32> ReplicatedDefinitionHashes;
+
+	/** @brief [Server] SkillTreeTypeTag per tree index at the last UpdateReplicatedDefinitionHashes, used to remap tree indices. */
+	TArray<FGameplayTag> ReplicatedTreeTypeTags;
+
+	/** @brief [Client] Set once Server_RequestGuidAddressedNodeStates has been sent, so it is only sent once. */
+	bool bRequestedGuidAddressedNodeStates = false;
+
+	/**
+	 * @brief Delta-replicated array holding the minimal state data for all assigned nodes.
 	 */
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_ReplicatedNodeStates)
-	TArray<FReplicatedNodeState> ReplicatedNodeStates;
+	FReplicatedNodeStateArray ReplicatedNodeStates;
 
 	/**
-	 * @brief Replicated array holding the total amount of each resource type that has been spent.
+	 * @brief Delta-replicated array holding the total amount of each resource type that has been spent.
 	 */
 	UPROPERTY(Transient, ReplicatedUsing = OnRep_AllocatedResourcesChanged)
-	TArray<FReplicatedResourceAllocation> ReplicatedAllocatedResources;
+	FReplicatedResourceAllocationArray ReplicatedAllocatedResources;
+
+	friend struct FReplicatedNodeState;
+	friend struct FReplicatedResourceAllocation;
+};
+
+/**
+ * @struct FCrimsonSkillTreeBulkApplyScope
+ * @brief RAII guard for a bulk-apply transaction on a skill tree manager.
+ * @details Opened by LoadSkillTreeState, Server_ForceUnassignAllNodesInTree, the Server_ForceUnlock* actions,
+ * Server_RequestSkillNodeAction and ApplyNodeActionBatch, so restoring hundreds of nodes produces one broadcast, one
+ * replication update and one save instead of one of each per node. Nested scopes are free; only the outermost one
+ * flushes.
+ */
+struct FCrimsonSkillTreeBulkApplyScope
+{
+	explicit FCrimsonSkillTreeBulkApplyScope(UCrimsonSkillTreeManager* InManager)
+		: Manager(InManager)
+	{
+		if (Manager)
+		{
+			Manager->BeginBulkApply();
+		}
+	}
+
+	~FCrimsonSkillTreeBulkApplyScope()
+	{
+		if (Manager)
+		{
+			Manager->EndBulkApply();
+		}
+	}
+
+	UE_NONCOPYABLE(FCrimsonSkillTreeBulkApplyScope);
+
+private:
+	UCrimsonSkillTreeManager* Manager;
 };
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * @struct FCrimsonSkillTree_ResolvedProperty
+ * @brief A numeric property resolved by name on a specific class, ready for direct typed access.
+ */
+struct FCrimsonSkillTree_ResolvedProperty
+{
+	/** @brief The resolved property, or nullptr if the class has no numeric property with that name. */
+	const FNumericProperty* Property = nullptr;
+
+	/** @brief Byte offset of the property's value inside an instance of the class. */
+	int32 Offset = INDEX_NONE;
+
+	bool IsValid() const { return Property != nullptr; }
+
+	/**
+	 * @brief Gets a typed pointer to the property's value on an object.
+	 * @param Object An instance of the class this handle was resolved for.
+	 * @return The value pointer, or nullptr if the handle is invalid or the property is not of type PropertyType.
+	 */
+	template <typename PropertyType, typename ValueType>
+	ValueType* GetValuePtr(UObject* Object) const
+	{
+		return Property && Property->IsA<PropertyType>() ? reinterpret_cast<ValueType*>(reinterpret_cast<uint8*>(Object) + Offset) : nullptr;
+	}
+};
+
+/**
+ * @class FCrimsonSkillTree_PropertyCache
+ * @brief Per-class cache of numeric properties resolved by name.
+ * @details Budget reads for ENodeCostSource::ActorIntegerProperty and writes by
+ * UCrimsonSkillTree_NodeEvent_ModifyCharacterFloatProperty both address a property by FName. This cache runs the
+ * FindFProperty search once per (class, name) pair and stores the property and its offset, so repeated accesses are a
+ * map lookup followed by a direct typed memory access. Misses are cached too, so a misconfigured name is only searched
+ * for once. Entries are keyed by weak class pointer; a class that is regenerated (Blueprint recompile, hot reload)
+ * gets a new UClass and is resolved again.
+ * Game thread only.
+ */
+class CRIMSONSKILLTREE_API FCrimsonSkillTree_PropertyCache
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	/**
+	 * @brief Gets the cache singleton.
+	 * @return The cache.
+	 */
+	static FCrimsonSkillTree_PropertyCache& Get();
+
+	/**
+	 * @brief Resolves a numeric property on a class, searching only on the first request for the pair.
+	 * @param Class The class that declares or inherits the property.
+	 * @param PropertyName The name of the property.
+	 * @return The resolved handle. Invalid if the class has no numeric property with that name.
+	 */
+	const FCrimsonSkillTree_ResolvedProperty& Resolve(const UClass* Class, FName PropertyName)
+	{
+		check(IsInGameThread());
+		const FCacheKey Key(Class, PropertyName);
+		if (const FCrimsonSkillTree_ResolvedProperty* Found = ResolvedProperties.Find(Key))
+		{
+			return *Found;
+		}
+
+		FCrimsonSkillTree_ResolvedProperty Resolved;
+		if (Class && PropertyName != NAME_None)
+		{
+			if (const FNumericProperty* Property = FindFProperty<FNumericProperty>(Class, PropertyName))
+			{
+				Resolved.Property = Property;
+				Resolved.Offset = Property->GetOffset_ForInternal();
+			}
+		}
+		return ResolvedProperties.Add(Key, Resolved);
+	}
+
+	/**
+	 * @brief Reads an int32 property from an object.
+	 * @param Object The object to read from.
+	 * @param PropertyName The name of the FIntProperty.
+	 * @param OutValue Receives the value.
+	 * @return True if the property exists and is an FIntProperty.
+	 */
+	bool ReadInt(const UObject* Object, FName PropertyName, int32& OutValue)
+	{
+		if (!Object)
+		{
+			return false;
+		}
+
+		const int32* ValuePtr = Resolve(Object->GetClass(), PropertyName).GetValuePtr<FIntProperty, int32>(const_cast<UObject*>(Object));
+		if (!ValuePtr)
+		{
+			return false;
+		}
+		OutValue = *ValuePtr;
+		return true;
+	}
+
+	/**
+	 * @brief Adds a delta to a float or double property on an object.
+	 * @param Object The object to modify.
+	 * @param PropertyName The name of the FFloatProperty or FDoubleProperty.
+	 * @param Delta The amount to add.
+	 * @return True if the property exists and is a floating point property.
+	 */
+	bool AddToFloatingPoint(UObject* Object, FName PropertyName, double Delta)
+	{
+		if (!Object)
+		{
+			return false;
+		}
+
+		const FCrimsonSkillTree_ResolvedProperty& Resolved = Resolve(Object->GetClass(), PropertyName);
+		if (float* FloatPtr = Resolved.GetValuePtr<FFloatProperty, float>(Object))
+		{
+			*FloatPtr += static_cast<float>(Delta);
+			return true;
+		}
+		if (double* DoublePtr = Resolved.GetValuePtr<FDoubleProperty, double>(Object))
+		{
+			*DoublePtr += Delta;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief Drops every cached entry, e.g. after a module reload.
+	 */
+	void Reset()
+	{
+		ResolvedProperties.Reset();
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	using FCacheKey = TPair<TWeakObjectPtr<const UClass>, FName>;
+
+	/** @brief (class, property name) -> resolved handle. */
+	TMap<FCacheKey, FCrimsonSkillTree_ResolvedProperty> ResolvedProperties;
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UCrimsonSkillTree_Node;
+
+/**
+ * @struct FCrimsonSkillTree_EventCoalescer
+ * @brief Collapses the level transitions of each node during a bulk-apply transaction into one net transition.
+ * @details A restore with bForceEventExecutionFromLevelZero, or a force-unlock to max level, steps a node through
+ * every level. Each step would otherwise fire OnLevelUp on every event, and ApplyGameplayEffect or
+ * GrantGameplayAbility would remove and re-apply their effect or ability each time, rebuilding the ASC aggregators.
+ * While a transaction is open the manager records transitions here instead. When it closes, each node fires its
+ * events once with (OriginalLevel -> FinalLevel): OnLevelUp if it went up, OnLevelDown if it went down, OnNodeReset if
+ * it was reset and ended at level 0, and nothing if it ended where it started.
+ */
+struct FCrimsonSkillTree_EventCoalescer
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	/**
+	 * @brief Records a level change. Only the first OldLevel and the last NewLevel of a node are kept.
+	 * @param Node The node whose level changed.
+	 * @param OldLevel The level before this step.
+	 * @param NewLevel The level after this step.
+	 */
+	void RecordLevelChange(UCrimsonSkillTree_Node* Node, int32 OldLevel, int32 NewLevel)
+	{
+		FPendingTransition& Transition = FindOrAddTransition(Node, OldLevel);
+		Transition.FinalLevel = NewLevel;
+	}
+
+	/**
+	 * @brief Records a forced reset to level 0.
+	 * @param Node The node being reset.
+	 * @param PreviousLevel The level before the reset.
+	 */
+	void RecordReset(UCrimsonSkillTree_Node* Node, int32 PreviousLevel)
+	{
+		FPendingTransition& Transition = FindOrAddTransition(Node, PreviousLevel);
+		Transition.FinalLevel = 0;
+		Transition.bWasReset = true;
+	}
+
+	bool IsEmpty() const { return Pending.Num() == 0; }
+
+	/**
+	 * @brief Emits one net transition per node, in the order the nodes were first recorded, and clears the coalescer.
+	 * @param ExecuteTransition Called with (Node, OriginalLevel, FinalLevel, bIsReset). Not called for nodes that ended
+	 * at their original level. bIsReset is true only when the node was reset and ended at level 0.
+	 */
+	template <typename FuncType>
+	void Flush(FuncType&& ExecuteTransition)
+	{
+		// Swap out first: events may change levels again, which starts a new coalescing window.
+		TArray<FPendingTransition> ToExecute = MoveTemp(Pending);
+		Pending.Reset();
+		IndexByNode.Reset();
+
+		for (const FPendingTransition& Transition : ToExecute)
+		{
+			UCrimsonSkillTree_Node* Node = Transition.Node.Get();
+			if (!Node || Transition.OriginalLevel == Transition.FinalLevel)
+			{
+				continue;
+			}
+			ExecuteTransition(Node, Transition.OriginalLevel, Transition.FinalLevel, Transition.bWasReset && Transition.FinalLevel == 0);
+		}
+	}
+
+	void Reset()
+	{
+		Pending.Reset();
+		IndexByNode.Reset();
+	}
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	struct FPendingTransition
+	{
+		TWeakObjectPtr<UCrimsonSkillTree_Node> Node;
+		int32 OriginalLevel = 0;
+		int32 FinalLevel = 0;
+		bool bWasReset = false;
+	};
+
+	FPendingTransition& FindOrAddTransition(UCrimsonSkillTree_Node* Node, int32 OriginalLevel)
+	{
+		if (const int32* ExistingIndex = IndexByNode.Find(Node))
+		{
+			return Pending[*ExistingIndex];
+		}
+
+		const int32 NewIndex = Pending.AddDefaulted();
+		IndexByNode.Add(Node, NewIndex);
+		FPendingTransition& Transition = Pending[NewIndex];
+		Transition.Node = Node;
+		Transition.OriginalLevel = OriginalLevel;
+		Transition.FinalLevel = OriginalLevel;
+		return Transition;
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief Pending transitions in first-recorded order. */
+	TArray<FPendingTransition> Pending;
+
+	/** @brief Node -> index into Pending. */
+	TMap<const UCrimsonSkillTree_Node*, int32> IndexByNode;
+};
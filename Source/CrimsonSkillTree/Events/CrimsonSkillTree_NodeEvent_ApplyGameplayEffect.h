@@ -78,6 +78,8 @@ protected:
 	// =============================================================================================================
 	/**
 	 * @brief Applies the configured GameplayEffect to the owner's ASC or updates it if already active.
+	 * @details Inside a manager bulk-apply transaction this runs once per node with the net level change, because the
+	 * manager's FCrimsonSkillTree_EventCoalescer collapses the individual level steps.
 	 * @param ASC The AbilitySystemComponent to apply the effect to.
 	 * @param EffectLevel The level at which to apply/update the effect.
 	 * @param SourceTags Optional tags to add to the effect context.
@@ -69,6 +69,7 @@ protected:
 	// =============================================================================================================
 	/**
 	 * @brief Grants the configured GameplayAbility to the owner's ASC or updates its level if already granted.
+	 * @details Inside a manager bulk-apply transaction this runs once per node with the net level change (see FCrimsonSkillTree_EventCoalescer).
 	 * @param ASC The AbilitySystemComponent to grant the ability to.
 	 * @param AbilityLevelToGrant The level at which to grant the ability.
 	 */
@@ -80,6 +80,8 @@ protected:
 	// =============================================================================================================
 	/**
 	 * @brief Helper function to find and apply the float property modification.
+	 * @details The property is resolved through FCrimsonSkillTree_PropertyCache, so only the first modification per
+	 * target class searches by TargetPropertyName; later ones write through the cached offset.
 	 * @param DeltaTotalValue The total change to apply to the property (can be positive or negative).
 	 */
 	void ApplyModification(float DeltaTotalValue) const;
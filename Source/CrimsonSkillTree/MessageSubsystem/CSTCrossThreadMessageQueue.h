@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LockFreeList.h"
+#include "Containers/MpscQueue.h"
+#include "GameplayTagContainer.h"
+#include "UObject/GarbageCollection.h"
+
+#include <atomic>
+
+/**
+ * Producer side of UCSTMessageSubsystem's cross-thread delivery, shared between the subsystem and worker tasks
+ *
+ * Get one on the game thread with UCSTMessageSubsystem::GetCrossThreadProducer and capture the shared reference by value
+ * in the task, e.g.
+ *    UE::Tasks::Launch(TEXT("Plan"), [Producer = Router.GetCrossThreadProducer()]() { Producer->BroadcastMessage(Channel, Result); });
+ * The task then never touches the subsystem itself. Deinitialize closes the queue: later messages are dropped, and
+ * whichever side releases the last reference destroys the undelivered payloads and frees the pools.
+ *
+ * Payloads are copied into blocks from per-size-class lock-free pools, so steady-state publishing does not allocate.
+ * Messages from one producer thread arrive in order.
+ *
+ * Producers hold an FGCScopeGuard from the copy until the message is on the queue, so a collection never runs while a
+ * payload is half-written or has been enqueued but not yet reported. Every message enqueued before a collection
+ * starts is moved off the queue by UCSTMessageSubsystem::HandlePreGarbageCollect, which runs under the GC lock, and
+ * reported from there.
+ */
+class FCSTCrossThreadMessageQueue
+{
+public:
+	// A message published from a worker thread
+	struct FMessage
+	{
+		FGameplayTag Channel;
+		const UScriptStruct* StructType = nullptr;
+
+		// Pooled block holding the copied payload; returned to its pool by Release
+		uint8* Payload = nullptr;
+		int32 SizeClass = INDEX_NONE;
+	};
+
+	FCSTCrossThreadMessageQueue() = default;
+	UE_NONCOPYABLE(FCSTCrossThreadMessageQueue);
+
+	~FCSTCrossThreadMessageQueue()
+	{
+		Close();
+
+		FMessage Message;
+		while (Messages.Dequeue(Message))
+		{
+			Release(Message);
+		}
+
+		for (TLockFreePointerListUnordered<uint8, PLATFORM_CACHE_LINE_SIZE>& Pool : Pools)
+		{
+			while (uint8* Block = Pool.Pop())
+			{
+				FMemory::Free(Block);
+			}
+		}
+	}
+
+	/**
+	 * Publish a message from any thread
+	 * @param Message			The message to send; must be safe to copy off the game thread (no UObject construction)
+	 * @return false if the subsystem has shut down and the message was dropped
+	 */
+	template <typename FMessageStructType>
+	bool BroadcastMessage(FGameplayTag Channel, const FMessageStructType& Message)
+	{
+		return Enqueue(Channel, TBaseStructure<FMessageStructType>::Get(), &Message);
+	}
+
+	// Untyped BroadcastMessage; callable from any thread
+	bool Enqueue(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+	{
+		if (!StructType || bClosed.load(std::memory_order_acquire))
+		{
+			return false;
+		}
+
+		// Blocks GC until the payload, and any UObject it references, is on the queue where the pre-GC drain finds it
+		FGCScopeGuard GCGuard;
+
+		const int32 PayloadSize = FMath::Max(StructType->GetStructureSize(), 1);
+		const int32 SizeClass = StructType->GetMinAlignment() <= PayloadAlignment ? GetPayloadSizeClass(PayloadSize) : INDEX_NONE;
+
+		uint8* Payload = SizeClass != INDEX_NONE ? Pools[SizeClass].Pop() : nullptr;
+		if (!Payload)
+		{
+			const int32 BlockSize = SizeClass != INDEX_NONE ? GetSizeClassBytes(SizeClass) : PayloadSize;
+			Payload = static_cast<uint8*>(FMemory::Malloc(BlockSize, FMath::Max<int32>(StructType->GetMinAlignment(), PayloadAlignment)));
+		}
+
+		StructType->InitializeStruct(Payload);
+		StructType->CopyScriptStruct(Payload, MessageBytes);
+		Messages.Enqueue(FMessage{ Channel, StructType, Payload, SizeClass });
+		return true;
+	}
+
+	// Game thread: moves every message published so far to the end of OutMessages
+	void DequeueAll(TArray<FMessage>& OutMessages)
+	{
+		FMessage Message;
+		while (Messages.Dequeue(Message))
+		{
+			OutMessages.Add(Message);
+		}
+	}
+
+	// Destroys a dequeued payload with DestroyStruct and returns its block to the pool
+	void Release(FMessage& Message)
+	{
+		if (!Message.Payload)
+		{
+			return;
+		}
+
+		Message.StructType->DestroyStruct(Message.Payload);
+		if (Message.SizeClass != INDEX_NONE)
+		{
+			Pools[Message.SizeClass].Push(Message.Payload);
+		}
+		else
+		{
+			FMemory::Free(Message.Payload);
+		}
+		Message.Payload = nullptr;
+	}
+
+	// Stop accepting messages; called by UCSTMessageSubsystem::Deinitialize
+	void Close() { bClosed.store(true, std::memory_order_release); }
+
+	bool IsClosed() const { return bClosed.load(std::memory_order_acquire); }
+
+private:
+	// Size classes of the payload pools; larger or over-aligned payloads bypass the pools
+	static constexpr int32 NumPayloadSizeClasses = 4;
+	static constexpr int32 MinPayloadSize = 64;
+	static constexpr int32 PayloadAlignment = 16;
+
+	static constexpr int32 GetSizeClassBytes(int32 SizeClass) { return MinPayloadSize << SizeClass; }
+
+	// @return the pool index for a payload size, or INDEX_NONE if it is larger than the largest size class
+	static int32 GetPayloadSizeClass(int32 PayloadSize)
+	{
+		for (int32 SizeClass = 0; SizeClass < NumPayloadSizeClasses; ++SizeClass)
+		{
+			if (PayloadSize <= GetSizeClassBytes(SizeClass))
+			{
+				return SizeClass;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+private:
+	// Messages pushed by worker threads, drained on the game thread
+	TMpscQueue<FMessage> Messages;
+
+	// Free payload blocks per size class; popped by producers and refilled by Release
+	TLockFreePointerListUnordered<uint8, PLATFORM_CACHE_LINE_SIZE> Pools[NumPayloadSizeClasses];
+
+	// Set by Close; producers drop messages once it is set
+	std::atomic<bool> bClosed{ false };
+};
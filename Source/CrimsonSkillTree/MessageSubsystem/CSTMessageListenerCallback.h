@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+#include <type_traits>
+
+/**
+ * Move-only, type-erased listener callback with small-buffer storage
+ * Callables up to InlineSize bytes (lambdas capturing a weak object pointer and a member function, or a single
+ * TFunction) are stored in place, so binding one does not allocate. Larger callables fall back to a single heap block.
+ * Replaces the TFunction thunk wrapping a second TFunction that every listener used to own.
+ */
+class FCSTMessageListenerCallback
+{
+public:
+	static constexpr int32 InlineSize = 48;
+
+	FCSTMessageListenerCallback() = default;
+
+	template <typename FuncType, typename = std::enable_if_t<!std::is_same_v<std::decay_t<FuncType>, FCSTMessageListenerCallback>>>
+	FCSTMessageListenerCallback(FuncType&& Func)
+	{
+		Bind(Forward<FuncType>(Func));
+	}
+
+	FCSTMessageListenerCallback(FCSTMessageListenerCallback&& Other)
+	{
+		MoveFrom(Other);
+	}
+
+	FCSTMessageListenerCallback& operator=(FCSTMessageListenerCallback&& Other)
+	{
+		if (this != &Other)
+		{
+			Reset();
+			MoveFrom(Other);
+		}
+		return *this;
+	}
+
+	FCSTMessageListenerCallback(const FCSTMessageListenerCallback&) = delete;
+	FCSTMessageListenerCallback& operator=(const FCSTMessageListenerCallback&) = delete;
+
+	~FCSTMessageListenerCallback()
+	{
+		Reset();
+	}
+
+	// Replace the bound callable
+	template <typename FuncType>
+	void Bind(FuncType&& Func)
+	{
+		using FStoredType = std::decay_t<FuncType>;
+
+		Reset();
+		if constexpr (sizeof(FStoredType) <= InlineSize && alignof(FStoredType) <= alignof(FStorage))
+		{
+			new (&Storage) FStoredType(Forward<FuncType>(Func));
+			Ops = &TInlineOps<FStoredType>::Ops;
+		}
+		else
+		{
+			*reinterpret_cast<FStoredType**>(&Storage) = new FStoredType(Forward<FuncType>(Func));
+			Ops = &THeapOps<FStoredType>::Ops;
+		}
+	}
+
+	void Reset()
+	{
+		if (Ops)
+		{
+			Ops->Destroy(&Storage);
+			Ops = nullptr;
+		}
+	}
+
+	bool IsBound() const { return Ops != nullptr; }
+
+	void operator()(FGameplayTag Channel, const UScriptStruct* StructType, const void* Payload) const
+	{
+		check(Ops);
+		Ops->Invoke(const_cast<FStorage*>(&Storage), Channel, StructType, Payload);
+	}
+
+private:
+	struct alignas(16) FStorage
+	{
+		uint8 Bytes[InlineSize];
+	};
+
+	struct FOps
+	{
+		void (*Invoke)(void* Storage, FGameplayTag Channel, const UScriptStruct* StructType, const void* Payload);
+		void (*Relocate)(void* Dest, void* Src);
+		void (*Destroy)(void* Storage);
+	};
+
+	// Callable constructed directly in Storage
+	template <typename FStoredType>
+	struct TInlineOps
+	{
+		static void Invoke(void* InStorage, FGameplayTag Channel, const UScriptStruct* StructType, const void* Payload)
+		{
+			(*static_cast<FStoredType*>(InStorage))(Channel, StructType, Payload);
+		}
+
+		static void Relocate(void* Dest, void* Src)
+		{
+			new (Dest) FStoredType(MoveTemp(*static_cast<FStoredType*>(Src)));
+			static_cast<FStoredType*>(Src)->~FStoredType();
+		}
+
+		static void Destroy(void* InStorage)
+		{
+			static_cast<FStoredType*>(InStorage)->~FStoredType();
+		}
+
+		static constexpr FOps Ops = { &Invoke, &Relocate, &Destroy };
+	};
+
+	// Storage holds a pointer to a heap-allocated callable
+	template <typename FStoredType>
+	struct THeapOps
+	{
+		static void Invoke(void* InStorage, FGameplayTag Channel, const UScriptStruct* StructType, const void* Payload)
+		{
+			(**static_cast<FStoredType**>(InStorage))(Channel, StructType, Payload);
+		}
+
+		static void Relocate(void* Dest, void* Src)
+		{
+			*static_cast<FStoredType**>(Dest) = *static_cast<FStoredType**>(Src);
+		}
+
+		static void Destroy(void* InStorage)
+		{
+			delete *static_cast<FStoredType**>(InStorage);
+		}
+
+		static constexpr FOps Ops = { &Invoke, &Relocate, &Destroy };
+	};
+
+	void MoveFrom(FCSTMessageListenerCallback& Other)
+	{
+		if (Other.Ops)
+		{
+			Other.Ops->Relocate(&Storage, &Other.Storage);
+			Ops = Other.Ops;
+			Other.Ops = nullptr;
+		}
+	}
+
+private:
+	FStorage Storage;
+	const FOps* Ops = nullptr;
+};
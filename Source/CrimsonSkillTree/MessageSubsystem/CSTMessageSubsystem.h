@@ -3,6 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/ChunkedArray.h"
+#include "Containers/Ticker.h"
+#include "CSTCrossThreadMessageQueue.h"
+#include "CSTMessageListenerCallback.h"
 #include "CSTMessageTypes.h"
 #include "GameplayTagContainer.h"
 #include "Subsystems/GameInstanceSubsystem.h"
@@ -36,14 +40,19 @@ private:
 	UPROPERTY(Transient)
 	FGameplayTag Channel;
 
+	// Listener slot index + 1
 	UPROPERTY(Transient)
 	int32 ID = 0;
 
+	// Generation of the slot when this handle was issued; a handle whose listener was already removed no longer matches
+	UPROPERTY(Transient)
+	int32 Generation = 0;
+
 	FDelegateHandle StateClearedHandle;
 
 	friend UCSTMessageSubsystem;
 
-	FCSTMessageListenerHandle(UCSTMessageSubsystem* InSubsystem, FGameplayTag InChannel, int32 InID) : Subsystem(InSubsystem), Channel(InChannel), ID(InID) {}
+	FCSTMessageListenerHandle(UCSTMessageSubsystem* InSubsystem, FGameplayTag InChannel, int32 InID, int32 InGeneration) : Subsystem(InSubsystem), Channel(InChannel), ID(InID), Generation(InGeneration) {}
 };
 
 /** 
@@ -55,7 +64,7 @@ struct FCSTMessageListenerData
 	GENERATED_BODY()
 
 	// Callback for when a message has been received
-	TFunction<void(FGameplayTag, const UScriptStruct*, const void*)> ReceivedCallback;
+	FCSTMessageListenerCallback ReceivedCallback;
 
 	int32 HandleID;
 	ECSTMessageMatch MatchType;
@@ -65,6 +74,16 @@ struct FCSTMessageListenerData
 	bool bHadValidType = false;
 };
 
+template<>
+struct TStructOpsTypeTraits<FCSTMessageListenerData> : public TStructOpsTypeTraitsBase2<FCSTMessageListenerData>
+{
+	enum
+	{
+		// ReceivedCallback is move-only
+		WithCopy = false,
+	};
+};
+
 
 /**
  * This system allows event raisers and listeners to register for messages without
@@ -100,25 +119,127 @@ public:
 	static bool HasInstance(const UObject* WorldContextObject);
 
 	//~USubsystem interface
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 	//~End of USubsystem interface
 
+	//~UObject interface
+	// Reports the UObject references held by messages waiting for end-of-frame delivery (e.g. a node pointer in a UI message)
+	// and by cross-thread messages moved off the producer queue before this collection (see HandlePreGarbageCollect)
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+	{
+		UCSTMessageSubsystem* This = CastChecked<UCSTMessageSubsystem>(InThis);
+		for (const FQueuedMessage& QueuedMessage : This->QueuedMessages)
+		{
+			if (QueuedMessage.StructType)
+			{
+				Collector.AddPropertyReferences(QueuedMessage.StructType, This->QueuedPayloadBuffer.GetData() + QueuedMessage.PayloadOffset, This);
+			}
+		}
+		for (const FCSTCrossThreadMessageQueue::FMessage& CrossThreadMessage : This->PendingCrossThreadMessages)
+		{
+			if (CrossThreadMessage.Payload)
+			{
+				Collector.AddPropertyReferences(CrossThreadMessage.StructType, CrossThreadMessage.Payload, This);
+			}
+		}
+		Super::AddReferencedObjects(InThis, Collector);
+	}
+	//~End of UObject interface
+
 	/**
 	 * Broadcast a message on the specified channel
+	 * If the channel has been opted into queued delivery (see SetChannelQueued), the message is copied and delivered at the end of the frame instead
 	 *
 	 * @param Channel			The message channel to broadcast on
 	 * @param Message			The message to send (must be the same type of UScriptStruct expected by the listeners for this channel, otherwise an error will be logged)
 	 */
 	template <typename FMessageStructType>
 	void BroadcastMessage(FGameplayTag Channel, const FMessageStructType& Message)
+	{
+		DeliverMessage(Channel, TBaseStructure<FMessageStructType>::Get(), &Message);
+	}
+
+	/**
+	 * Broadcast a message that supersedes any earlier message with the same key on the same channel in this frame
+	 * On queued channels only the last message per (Channel, CoalesceKey) is delivered at the end of the frame, e.g. the final state of each node during a load
+	 * On other channels this behaves like BroadcastMessage
+	 *
+	 * @param Channel			The message channel to broadcast on
+	 * @param Message			The message to send
+	 * @param CoalesceKey		Identifies what the message is about, e.g. a hash of the node GUID
+	 */
+	template <typename FMessageStructType>
+	void BroadcastMessageCoalesced(FGameplayTag Channel, const FMessageStructType& Message, uint64 CoalesceKey)
 	{
 		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
+		if (IsChannelQueued(Channel))
+		{
+			QueueMessageInternal(Channel, StructType, &Message, CoalesceKey, true);
+			return;
+		}
 		BroadcastMessageInternal(Channel, StructType, &Message);
 	}
 
+	/**
+	 * Opt a channel (and every channel below it) in or out of queued, end-of-frame delivery
+	 * Opting out flushes nothing; messages already queued are still delivered at the end of the frame
+	 */
+	void SetChannelQueued(FGameplayTag Channel, bool bQueued);
+
+	/** @return true if messages on the channel are queued rather than delivered immediately */
+	bool IsChannelQueued(FGameplayTag Channel) const
+	{
+		return QueuedChannels.Num() > 0 && Channel.MatchesAny(QueuedChannels);
+	}
+
+	/**
+	 * Deliver every queued message now, in the order they were first queued
+	 * Each payload is destroyed with DestroyStruct once it has been delivered, releasing whatever it owned (strings, arrays)
+	 */
+	void FlushQueuedMessages();
+
+	/**
+	 * Broadcast a message from any thread
+	 * On the game thread this is BroadcastMessage. On other threads the message is pushed onto the cross-thread queue
+	 * that the game thread drains once per frame, so worker tasks (simulation, save decoding, planning) can publish
+	 * results without an AsyncTask(GameThread) per message. Drained messages go through the same IsChannelQueued routing
+	 * as BroadcastMessage. Listeners are always called on the game thread.
+	 * Calling this from a worker requires the subsystem to outlive the call; tasks that may outlive it should capture
+	 * GetCrossThreadProducer() instead.
+	 *
+	 * @param Channel			The message channel to broadcast on
+	 * @param Message			The message to send; must be safe to copy off the game thread (no UObject construction).
+	 *							UObjects it references must be alive when the call starts. The producer holds an
+	 *							FGCScopeGuard while copying and enqueuing, so GC cannot run in between
+	 */
+	template <typename FMessageStructType>
+	void BroadcastMessageFromAnyThread(FGameplayTag Channel, const FMessageStructType& Message)
+	{
+		if (IsInGameThread())
+		{
+			BroadcastMessage(Channel, Message);
+			return;
+		}
+		CrossThreadQueue->BroadcastMessage(Channel, Message);
+	}
+
+	/**
+	 * Get the thread-safe producer handle for this subsystem's cross-thread queue; game thread only
+	 * Capture the returned reference by value in worker tasks (see FCSTCrossThreadMessageQueue). It stays valid after the
+	 * subsystem is deinitialized; messages published after that are dropped.
+	 */
+	TSharedRef<FCSTCrossThreadMessageQueue, ESPMode::ThreadSafe> GetCrossThreadProducer() const
+	{
+		check(IsInGameThread());
+		return CrossThreadQueue.ToSharedRef();
+	}
+
 	/**
 	 * Register to receive messages on a specified channel
 	 *
+	 * FMessageStructType is deduced from the TFunction
+	 *
 	 * @param Channel			The message channel to listen to
 	 * @param Callback			Function to call with the message when someone broadcasts it (must be the same type of UScriptStruct provided by broadcasters for this channel, otherwise an error will be logged)
 	 *
@@ -127,13 +248,24 @@ public:
 	template <typename FMessageStructType>
 	FCSTMessageListenerHandle RegisterListener(FGameplayTag Channel, TFunction<void(FGameplayTag, const FMessageStructType&)>&& Callback, ECSTMessageMatch MatchType = ECSTMessageMatch::ExactMatch)
 	{
-		auto ThunkCallback = [InnerCallback = MoveTemp(Callback)](FGameplayTag ActualTag, const UScriptStruct* SenderStructType, const void* SenderPayload)
-		{
-			InnerCallback(ActualTag, *reinterpret_cast<const FMessageStructType*>(SenderPayload));
-		};
+		return RegisterTypedListener<FMessageStructType>(Channel, MoveTemp(Callback), MatchType);
+	}
 
-		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
-		return RegisterListenerInternal(Channel, ThunkCallback, StructType, MatchType);
+	/**
+	 * Register to receive messages on a specified channel with any callable, e.g. a lambda
+	 *
+	 * FMessageStructType must be named explicitly (RegisterListener<FMyMessage>(...)) since it cannot be deduced from a
+	 * lambda. The callable is stored directly in the listener's inline buffer, without an intermediate TFunction
+	 *
+	 * @param Channel			The message channel to listen to
+	 * @param Callback			Callable invoked with the message when someone broadcasts it (must be the same type of UScriptStruct provided by broadcasters for this channel, otherwise an error will be logged)
+	 *
+	 * @return a handle that can be used to unregister this listener (either by calling Unregister() on the handle or calling UnregisterListener on the router)
+	 */
+	template <typename FMessageStructType, typename FuncType, typename = std::enable_if_t<std::is_invocable_v<FuncType&, FGameplayTag, const FMessageStructType&>>>
+	FCSTMessageListenerHandle RegisterListener(FGameplayTag Channel, FuncType&& Callback, ECSTMessageMatch MatchType = ECSTMessageMatch::ExactMatch)
+	{
+		return RegisterTypedListener<FMessageStructType>(Channel, Forward<FuncType>(Callback), MatchType);
 	}
 
 	/**
@@ -165,25 +297,42 @@ public:
 	 * The stateful part of this logic should probably be separated out to a separate system
 	 *
 	 * @param Channel			The message channel to listen to
-	 * @param Params			Structure containing details for advanced behavior
+	 * @param Params			Structure containing details for advanced behavior; its OnMessageReceivedCallback is copied, so the same Params can be registered again
 	 *
 	 * @return a handle that can be used to unregister this listener (either by calling Unregister() on the handle or calling UnregisterListener on the router)
 	 */
 	template <typename FMessageStructType>
-	FCSTMessageListenerHandle RegisterListener(FGameplayTag Channel, FCSTMessageListenerParams<FMessageStructType>& Params)
+	FCSTMessageListenerHandle RegisterListener(FGameplayTag Channel, const FCSTMessageListenerParams<FMessageStructType>& Params)
 	{
 		FCSTMessageListenerHandle Handle;
 
 		// Register to receive any future messages broadcast on this channel
 		if (Params.OnMessageReceivedCallback)
 		{
-			auto ThunkCallback = [InnerCallback = Params.OnMessageReceivedCallback](FGameplayTag ActualTag, const UScriptStruct* SenderStructType, const void* SenderPayload)
-			{
-				InnerCallback(ActualTag, *reinterpret_cast<const FMessageStructType*>(SenderPayload));
-			};
+			Handle = RegisterTypedListener<FMessageStructType>(Channel, CopyTemp(Params.OnMessageReceivedCallback), Params.MatchType);
+		}
+
+		return Handle;
+	}
+
+	/**
+	 * Register a temporary or moved-from Params structure
+	 * Its OnMessageReceivedCallback is moved into the listener instead of copied, which saves the TFunction copy
+	 *
+	 * @param Channel			The message channel to listen to
+	 * @param Params			Structure containing details for advanced behavior
+	 *
+	 * @return a handle that can be used to unregister this listener (either by calling Unregister() on the handle or calling UnregisterListener on the router)
+	 */
+	template <typename FMessageStructType>
+	FCSTMessageListenerHandle RegisterListener(FGameplayTag Channel, FCSTMessageListenerParams<FMessageStructType>&& Params)
+	{
+		FCSTMessageListenerHandle Handle;
 
-			const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
-			Handle = RegisterListenerInternal(Channel, ThunkCallback, StructType, Params.MatchType);
+		// Register to receive any future messages broadcast on this channel
+		if (Params.OnMessageReceivedCallback)
+		{
+			Handle = RegisterTypedListener<FMessageStructType>(Channel, MoveTemp(Params.OnMessageReceivedCallback), Params.MatchType);
 		}
 
 		return Handle;
@@ -209,26 +358,236 @@ protected:
 	DECLARE_FUNCTION(execK2_BroadcastMessage);
 
 private:
-	// Internal helper for broadcasting a message
+	// Delivers a message now, or queues it for the end of the frame if its channel is queued
+	void DeliverMessage(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes)
+	{
+		if (IsChannelQueued(Channel))
+		{
+			QueueMessageInternal(Channel, StructType, MessageBytes, 0, false);
+			return;
+		}
+		BroadcastMessageInternal(Channel, StructType, MessageBytes);
+	}
+
+	/**
+	 * Internal helper for broadcasting a message
+	 * Reentrant: callbacks may broadcast, register and unregister listeners. The delivery list is copied with
+	 * GatherDispatchTargets before the first callback runs, so nothing a callback does to DispatchCache can invalidate
+	 * the iteration. Listeners registered during the broadcast do not receive it; listeners unregistered during it are
+	 * skipped by ResolveDispatchTarget.
+	 */
 	void BroadcastMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes);
 
-	// Internal helper for registering a message listener
+	// Wraps a typed callable in the untyped thunk stored by RegisterListenerInternal; shared by every typed RegisterListener
+	template <typename FMessageStructType, typename FuncType>
+	FCSTMessageListenerHandle RegisterTypedListener(FGameplayTag Channel, FuncType&& Callback, ECSTMessageMatch MatchType)
+	{
+		// The callable is stored directly in the listener's inline buffer; no intermediate TFunction
+		auto ThunkCallback = [InnerCallback = Forward<FuncType>(Callback)](FGameplayTag ActualTag, const UScriptStruct* SenderStructType, const void* SenderPayload) mutable
+		{
+			InnerCallback(ActualTag, *reinterpret_cast<const FMessageStructType*>(SenderPayload));
+		};
+
+		const UScriptStruct* StructType = TBaseStructure<FMessageStructType>::Get();
+		return RegisterListenerInternal(Channel, MoveTemp(ThunkCallback), StructType, MatchType);
+	}
+
+	/**
+	 * Internal helper for registering a message listener
+	 * Takes a slot from the free list (growing ListenerSlots only when it is empty) and appends it to the channel's
+	 * list, so registration is O(1) and does not allocate once the pool and the channel list have warmed up
+	 */
 	FCSTMessageListenerHandle RegisterListenerInternal(
 		FGameplayTag Channel, 
-		TFunction<void(FGameplayTag, const UScriptStruct*, const void*)>&& Callback,
+		FCSTMessageListenerCallback&& Callback,
 		const UScriptStruct* StructType,
 		ECSTMessageMatch MatchType);
 
-	void UnregisterListenerInternal(FGameplayTag Channel, int32 HandleID);
+	/**
+	 * Removes the listener in a slot if Generation still matches, swap-removing it from its channel's list and
+	 * returning the slot to the free list. During a broadcast the callback is only destroyed once the broadcast ends,
+	 * since it may be the one currently executing.
+	 */
+	void UnregisterListenerInternal(int32 HandleID, int32 Generation);
+
+	// Destroys the callbacks of slots unregistered during a broadcast and frees the slots; called when BroadcastDepth returns to 0
+	void ReleasePendingListenerSlots();
+
+	/**
+	 * Copy a message into the frame's payload buffer and schedule it for end-of-frame delivery
+	 * The copy is made with InitializeStruct + CopyScriptStruct, and is reported to GC by AddReferencedObjects until it is delivered
+	 * With bCoalesce, a message already queued this frame with the same channel, key and struct type is overwritten in place
+	 */
+	void QueueMessageInternal(FGameplayTag Channel, const UScriptStruct* StructType, const void* MessageBytes, uint64 CoalesceKey, bool bCoalesce);
+
+	// Bound to FCoreDelegates::OnEndFrame while messages are queued
+	void HandleEndFrame();
+
+	/**
+	 * Game thread: moves every message pushed by other threads into PendingCrossThreadMessages, then delivers each one
+	 * through DeliverMessage (so queued channels stay queued) and releases its payload; ticked once per frame
+	 */
+	bool DrainCrossThreadMessages(float DeltaTime);
+
+	// Bound to FCoreUObjectDelegates::GetPreGarbageCollectDelegate(); moves queued cross-thread messages into
+	// PendingCrossThreadMessages so AddReferencedObjects can report them
+	void HandlePreGarbageCollect();
+
+	// A message waiting for end-of-frame delivery
+	struct FQueuedMessage
+	{
+		FGameplayTag Channel;
+		const UScriptStruct* StructType = nullptr;
+
+		// Byte offset of the payload in QueuedPayloadBuffer
+		int32 PayloadOffset = 0;
+	};
+
+	// One listener a broadcast on a given (channel, struct type) pair must be delivered to
+	struct FDispatchTarget
+	{
+		// Index into ListenerSlots; the target is stale once the slot's generation moves past Generation
+		int32 SlotIndex = INDEX_NONE;
+		int32 Generation = 0;
+	};
+
+	// Prebuilt delivery list for a (channel, struct type) pair
+	struct FDispatchList
+	{
+		// Exact listeners of the channel, then partial-match listeners of the channel and of every parent tag, with compatible struct types
+		TArray<FDispatchTarget> Targets;
+
+		// Listeners on the same channels whose struct type does not match; only kept to report the mismatch
+		TArray<FDispatchTarget> MismatchedTargets;
+
+		// ListenerGeneration this list was built for; rebuilt lazily on the next broadcast once it differs
+		uint32 BuiltForGeneration = 0;
+	};
+
+	/**
+	 * Returns the delivery list for a broadcast, building it on first use
+	 * The parent chain of the channel is walked and struct-type compatibility is checked only while building, so a
+	 * broadcast after that is a single pass over FDispatchList::Targets
+	 * A list whose BuiltForGeneration is behind ListenerGeneration is rebuilt in place, reusing its arrays
+	 * The reference points into DispatchCache and is invalidated by the next call (which may add an entry and rehash, or
+	 * rebuild this list); never hold it across a listener callback, use GatherDispatchTargets instead
+	 */
+	const FDispatchList& FindOrBuildDispatchList(FGameplayTag Channel, const UScriptStruct* StructType);
+
+	// Delivery targets copied out of DispatchCache for one broadcast; inline capacity covers typical channels without allocating
+	using FDispatchTargetArray = TArray<FDispatchTarget, TInlineAllocator<16>>;
+
+	// Copies the delivery list for a broadcast so it can be iterated while callbacks run
+	void GatherDispatchTargets(FGameplayTag Channel, const UScriptStruct* StructType, FDispatchTargetArray& OutTargets, FDispatchTargetArray& OutMismatchedTargets)
+	{
+		const FDispatchList& DispatchList = FindOrBuildDispatchList(Channel, StructType);
+		OutTargets = DispatchList.Targets;
+		OutMismatchedTargets = DispatchList.MismatchedTargets;
+	}
+
+	// Bumps ListenerGeneration so every prebuilt delivery list is rebuilt on its next use; called on register and unregister
+	void InvalidateDispatchCache() { ++ListenerGeneration; }
+
+	/**
+	 * Resolves a target, which may be stale because listeners changed during the current broadcast
+	 * @return the listener, or nullptr if it has been unregistered
+	 */
+	FCSTMessageListenerData* ResolveDispatchTarget(const FDispatchTarget& Target)
+	{
+		if (Target.SlotIndex < 0 || Target.SlotIndex >= ListenerSlots.Num())
+		{
+			return nullptr;
+		}
+		FListenerSlot& Slot = ListenerSlots[Target.SlotIndex];
+		return Slot.Generation == Target.Generation && Slot.ChannelListIndex != INDEX_NONE ? &Slot.Data : nullptr;
+	}
 
 private:
+	// Pooled storage for one listener
+	struct FListenerSlot
+	{
+		FCSTMessageListenerData Data;
+		FGameplayTag Channel;
+
+		// Bumped whenever the slot is released, so handles and dispatch targets for a previous occupant stop resolving
+		int32 Generation = 1;
+
+		// Position of this slot in its channel's FChannelListenerList::SlotIndices, or INDEX_NONE while the slot is free
+		int32 ChannelListIndex = INDEX_NONE;
+
+		// Next slot in the free list while this slot is free
+		int32 NextFreeSlot = INDEX_NONE;
+	};
+
 	// List of all entries for a given channel
 	struct FChannelListenerList
 	{
-		TArray<FCSTMessageListenerData> Listeners;
-		int32 HandleID = 0;
+		// Indices into ListenerSlots; unordered, listeners are swap-removed
+		TArray<int32> SlotIndices;
+
+		// Number of listeners registered with ECSTMessageMatch::PartialMatch; channels with none are skipped when walking a broadcast's parent chain
+		int32 NumPartialMatchListeners = 0;
 	};
 
+	// @return the listener slot a handle refers to, or nullptr if that listener has been unregistered
+	const FListenerSlot* FindListenerSlot(int32 HandleID, int32 Generation) const
+	{
+		const int32 SlotIndex = HandleID - 1;
+		if (SlotIndex < 0 || SlotIndex >= ListenerSlots.Num())
+		{
+			return nullptr;
+		}
+		const FListenerSlot& Slot = ListenerSlots[SlotIndex];
+		return Slot.Generation == Generation && Slot.ChannelListIndex != INDEX_NONE ? &Slot : nullptr;
+	}
+
 private:
 	TMap<FGameplayTag, FChannelListenerList> ListenerMap;
+
+	// Every listener slot ever allocated; chunked so slot addresses stay stable while a callback registers more listeners
+	TChunkedArray<FListenerSlot> ListenerSlots;
+
+	// Head of the free slot list, linked through FListenerSlot::NextFreeSlot
+	int32 FirstFreeListenerSlot = INDEX_NONE;
+
+	// Nesting depth of BroadcastMessageInternal; slots unregistered while it is non-zero are released afterwards
+	int32 BroadcastDepth = 0;
+
+	// Slots unregistered during a broadcast whose callbacks still need to be destroyed
+	TArray<int32> PendingReleaseListenerSlots;
+
+	// (channel, struct type) -> prebuilt delivery list
+	TMap<TPair<FGameplayTag, TObjectKey<UScriptStruct>>, FDispatchList> DispatchCache;
+
+	// Incremented whenever a listener is added or removed; delivery lists built for an older generation are rebuilt on use
+	uint32 ListenerGeneration = 0;
+
+	// Channels opted into queued delivery
+	FGameplayTagContainer QueuedChannels;
+
+	// Messages queued this frame, in first-queued order
+	TArray<FQueuedMessage> QueuedMessages;
+
+	// Payload storage for QueuedMessages; every payload is destroyed with DestroyStruct after the flush delivers it,
+	// then the buffer is reset (not freed) so steady-state queuing does not allocate
+	TArray<uint8, TAlignedHeapAllocator<16>> QueuedPayloadBuffer;
+
+	// (channel, coalesce key) -> index into QueuedMessages; reset after every flush
+	TMap<TPair<FGameplayTag, uint64>, int32> CoalescedMessageIndices;
+
+	// Handle of the OnEndFrame binding, valid while messages are queued
+	FDelegateHandle EndFrameHandle;
+
+	// Shared with producer handles; created in Initialize and closed (not reset) in Deinitialize, so a worker racing
+	// shutdown through BroadcastMessageFromAnyThread sees a closed queue rather than a null pointer
+	TSharedPtr<FCSTCrossThreadMessageQueue, ESPMode::ThreadSafe> CrossThreadQueue;
+
+	// Cross-thread messages taken off the queue but not yet delivered; game thread only, released in Deinitialize
+	TArray<FCSTCrossThreadMessageQueue::FMessage> PendingCrossThreadMessages;
+
+	// Handle of the pre-GC binding of HandlePreGarbageCollect
+	FDelegateHandle PreGarbageCollectHandle;
+
+	// Core ticker registration of DrainCrossThreadMessages
+	FTSTicker::FDelegateHandle CrossThreadDrainTickerHandle;
 };
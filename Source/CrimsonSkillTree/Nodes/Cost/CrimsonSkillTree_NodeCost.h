@@ -130,14 +130,17 @@ public:
 	****************************************************************************************************************/
 	/**
 	 * @brief Calculates the cost for a specific target level.
+	 * @details Evaluates the curve on every call. Runtime code reads the FNodeCostTable built from this cost in the
+	 * tree's shared definition instead; this is only used to build those tables and by editor tooling.
 	 * @param TargetLevel The level to calculate the cost for.
 	 * @param MaxLevel The maximum level of the node (for curve evaluation).
 	 * @return The calculated cost amount as an integer.
 	 */
 	int32 GetCostForTargetLevel(int32 TargetLevel, int32 MaxLevel) const
 	{
+		static const FString ContextString(TEXT("GetCostForTargetLevel"));
 		float FoundValue = 0.f;
-		if (CostCurveHandle.Eval(static_cast<float>(TargetLevel), &FoundValue, FString("GetCostForTargetLevel")))
+		if (CostCurveHandle.Eval(static_cast<float>(TargetLevel), &FoundValue, ContextString))
 		{
 			return FMath::RoundToInt(FoundValue);
 		}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_NodeCost.h"
+#include "CrimsonSkillTree_ResourceRegistry.h"
+
+/**
+ * @struct FNodeCostTable
+ * @brief One FNodeResourceCost resolved into a flat per-level array.
+ * @details Curve costs are evaluated once for every level from 1 to MaxLevel when the shared definition is built, so
+ * runtime cost queries (activation, refunds, invalidated-save refunds) are a bounds check and an array read.
+ * Index 0 holds the cost of level 1. A parallel prefix-sum array answers the cost of any level range, such as a
+ * full refund from level N to 0, with two reads.
+ */
+struct FNodeCostTable
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	/**
+	 * @brief Resolves every level of a resource cost.
+	 * @param InResourceCost The authored cost.
+	 * @param MaxLevel The maximum level of the owning node.
+	 */
+	void Build(const FNodeResourceCost& InResourceCost, int32 MaxLevel)
+	{
+		CostDefinition = InResourceCost.CostDefinition;
+		ResourceId = FCrimsonSkillTree_ResourceRegistry::Get().FindOrAddResourceId(CostDefinition);
+		const int32 NumLevels = FMath::Max(0, MaxLevel);
+		LevelCosts.SetNumUninitialized(NumLevels);
+		CumulativeCosts.SetNumUninitialized(NumLevels + 1);
+		CumulativeCosts[0] = 0;
+		for (int32 Level = 1; Level <= NumLevels; ++Level)
+		{
+			LevelCosts[Level - 1] = InResourceCost.GetCostForTargetLevel(Level, MaxLevel);
+			CumulativeCosts[Level] = CumulativeCosts[Level - 1] + LevelCosts[Level - 1];
+		}
+	}
+
+	/**
+	 * @brief Gets the cost of reaching a level from the level below it.
+	 * @param TargetLevel The level being purchased, 1-based.
+	 * @return The cost, or 0 if the level is outside the node's range.
+	 */
+	int32 GetCostForTargetLevel(int32 TargetLevel) const
+	{
+		return LevelCosts.IsValidIndex(TargetLevel - 1) ? LevelCosts[TargetLevel - 1] : 0;
+	}
+
+	/**
+	 * @brief Gets the total cost of every level from 1 to Level.
+	 * @param Level The level reached. Clamped to [0, MaxLevel].
+	 * @return The summed cost.
+	 */
+	int32 GetCumulativeCost(int32 Level) const
+	{
+		return CumulativeCosts.Num() > 0 ? CumulativeCosts[FMath::Clamp(Level, 0, CumulativeCosts.Num() - 1)] : 0;
+	}
+
+	/**
+	 * @brief Gets the total cost of moving between two levels in either direction.
+	 * @param FromLevel The starting level.
+	 * @param ToLevel The final level.
+	 * @return The cost of levels (min, max]. This is the amount spent when leveling up, or refunded when leveling down.
+	 */
+	int32 GetCostForLevelRange(int32 FromLevel, int32 ToLevel) const
+	{
+		return FMath::Abs(GetCumulativeCost(ToLevel) - GetCumulativeCost(FromLevel));
+	}
+
+	int32 GetNumLevels() const { return LevelCosts.Num(); }
+	SIZE_T GetAllocatedSize() const { return LevelCosts.GetAllocatedSize() + CumulativeCosts.GetAllocatedSize(); }
+
+public:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief The resource this table is priced in. */
+	FNodeCostDefinition CostDefinition;
+
+	/** @brief Interned ID of CostDefinition in FCrimsonSkillTree_ResourceRegistry. */
+	int32 ResourceId = INDEX_NONE;
+
+	/** @brief Resolved cost per level. Index 0 is level 1. */
+	TArray<int32> LevelCosts;
+
+	/** @brief Prefix sums of LevelCosts (MaxLevel + 1 entries). Index N is the total cost of levels 1..N. */
+	TArray<int32> CumulativeCosts;
+};
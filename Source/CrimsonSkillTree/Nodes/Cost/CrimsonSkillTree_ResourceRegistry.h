@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_NodeCost.h"
+
+/**
+ * @class FCrimsonSkillTree_ResourceRegistry
+ * @brief Process-wide interning table that maps each distinct FNodeCostDefinition to a small integer ResourceId.
+ * @details Cost definitions are interned once, when a tree's shared definition is built. After that, runtime code
+ * compares and indexes resources by ResourceId instead of hashing FName/FGameplayAttribute keys. The FText display
+ * name is only looked up through GetDefinition when the UI asks for it.
+ * ResourceIds depend on asset load order and are only valid within one process. They must never be replicated or
+ * saved; use the manager's resource slots for that.
+ * Game thread only.
+ */
+class CRIMSONSKILLTREE_API FCrimsonSkillTree_ResourceRegistry
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	/**
+	 * @brief Gets the registry singleton.
+	 * @return The registry.
+	 */
+	static FCrimsonSkillTree_ResourceRegistry& Get();
+
+	/**
+	 * @brief Interns a cost definition.
+	 * @param InCostDefinition The definition to intern.
+	 * @return The ResourceId of the definition. The same resource always returns the same ID.
+	 */
+	int32 FindOrAddResourceId(const FNodeCostDefinition& InCostDefinition)
+	{
+		check(IsInGameThread());
+		if (const int32* FoundId = IdByDefinition.Find(InCostDefinition))
+		{
+			return *FoundId;
+		}
+
+		const int32 NewId = Definitions.Add(InCostDefinition);
+		IdByDefinition.Add(InCostDefinition, NewId);
+		return NewId;
+	}
+
+	/**
+	 * @brief Finds the ResourceId of a cost definition without interning it.
+	 * @param InCostDefinition The definition to look up.
+	 * @return The ResourceId, or INDEX_NONE if the resource was never interned.
+	 */
+	int32 FindResourceId(const FNodeCostDefinition& InCostDefinition) const
+	{
+		const int32* FoundId = IdByDefinition.Find(InCostDefinition);
+		return FoundId ? *FoundId : INDEX_NONE;
+	}
+
+	/**
+	 * @brief Gets the definition behind a ResourceId, e.g. for its display name.
+	 * @param ResourceId A valid ResourceId.
+	 * @return The interned definition.
+	 */
+	const FNodeCostDefinition& GetDefinition(int32 ResourceId) const { return Definitions[ResourceId]; }
+
+	bool IsValidResourceId(int32 ResourceId) const { return Definitions.IsValidIndex(ResourceId); }
+	int32 Num() const { return Definitions.Num(); }
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief Interned definitions, indexed by ResourceId. Never shrinks, so IDs stay stable for the process lifetime. */
+	TArray<FNodeCostDefinition> Definitions;
+
+	/** @brief Definition -> ResourceId. Only used while interning. */
+	TMap<FNodeCostDefinition, int32> IdByDefinition;
+};
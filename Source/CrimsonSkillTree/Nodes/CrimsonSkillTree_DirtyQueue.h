@@ -0,0 +1,130 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_NodeBitset.h"
+#include "CrimsonSkillTree_SharedDefinition.h"
+
+/**
+ * @struct FCrimsonSkillTree_DirtyQueue
+ * @brief Per-tree queue of nodes whose overall state must be re-evaluated, drained in topological order.
+ * @details Replaces synchronous UpdateNodeOverallState cascades. Reactions to a state change (a parent's
+ * OnNodeStateChanged, a condition's met-state change) only mark the node dirty. Flush then pops nodes by ascending
+ * topological rank, so every parent is settled before its children, and each node is evaluated at most once per batch.
+ * A node that is marked again after it was evaluated in the current batch is carried over to the next batch instead
+ * of being evaluated twice.
+ */
+struct FCrimsonSkillTree_DirtyQueue
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	/**
+	 * @brief Sizes the queue for a tree.
+	 * @param InDefinition The tree's shared definition. Must outlive this queue.
+	 */
+	void Init(const FCrimsonSkillTree_SharedDefinition* InDefinition)
+	{
+		Definition = InDefinition;
+		const int32 NumNodes = Definition ? Definition->Num() : 0;
+		Queued.Init(NumNodes);
+		EvaluatedThisBatch.Init(NumNodes);
+		Heap.Reset();
+		CarriedOver.Reset();
+		bFlushing = false;
+	}
+
+	/**
+	 * @brief Marks a node for re-evaluation. Duplicate marks are ignored.
+	 * @param NodeIndex The dense index of the node.
+	 * @return True if the node was not already queued.
+	 */
+	bool MarkDirty(int32 NodeIndex)
+	{
+		if (!Definition || !Definition->IsValidIndex(NodeIndex) || Queued.Contains(NodeIndex))
+		{
+			return false;
+		}
+
+		Queued.Add(NodeIndex);
+		if (bFlushing && EvaluatedThisBatch.Contains(NodeIndex))
+		{
+			CarriedOver.Add(NodeIndex);
+		}
+		else
+		{
+			Heap.HeapPush(NodeIndex, FByRank(Definition));
+		}
+		return true;
+	}
+
+	bool IsEmpty() const { return Heap.Num() == 0 && CarriedOver.Num() == 0; }
+	bool IsFlushing() const { return bFlushing; }
+
+	/**
+	 * @brief Evaluates every queued node once, parents first.
+	 * @param EvaluateNode Called with the dense index of each node. May mark further nodes dirty.
+	 * @return The number of nodes evaluated.
+	 */
+	template <typename FuncType>
+	int32 Flush(FuncType&& EvaluateNode)
+	{
+		if (bFlushing || !Definition)
+		{
+			return 0;
+		}
+
+		TGuardValue<bool> FlushGuard(bFlushing, true);
+		EvaluatedThisBatch.ClearAll();
+		int32 NumEvaluated = 0;
+		while (Heap.Num() > 0)
+		{
+			int32 NodeIndex;
+			Heap.HeapPop(NodeIndex, FByRank(Definition), EAllowShrinking::No);
+			Queued.Remove(NodeIndex);
+			EvaluatedThisBatch.Add(NodeIndex);
+			EvaluateNode(NodeIndex);
+			++NumEvaluated;
+		}
+
+		for (const int32 NodeIndex : CarriedOver)
+		{
+			Heap.HeapPush(NodeIndex, FByRank(Definition));
+		}
+		CarriedOver.Reset();
+		return NumEvaluated;
+	}
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	struct FByRank
+	{
+		explicit FByRank(const FCrimsonSkillTree_SharedDefinition* InDefinition) : RankDefinition(InDefinition) {}
+		bool operator()(int32 A, int32 B) const { return RankDefinition->GetTopologicalRank(A) < RankDefinition->GetTopologicalRank(B); }
+		const FCrimsonSkillTree_SharedDefinition* RankDefinition;
+	};
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief The tree's shared definition, source of the topological ranks. */
+	const FCrimsonSkillTree_SharedDefinition* Definition = nullptr;
+
+	/** @brief Nodes currently in Heap or CarriedOver. */
+	FCrimsonSkillTree_NodeBitset Queued;
+
+	/** @brief Nodes already evaluated in the running Flush. */
+	FCrimsonSkillTree_NodeBitset EvaluatedThisBatch;
+
+	/** @brief Min-heap of dirty node indices by topological rank. */
+	TArray<int32> Heap;
+
+	/** @brief Nodes re-marked after being evaluated in the running Flush. Queued for the next batch. */
+	TArray<int32> CarriedOver;
+
+	/** @brief Set while Flush runs. Nested flushes are ignored; their nodes are drained by the running one. */
+	bool bFlushing = false;
+};
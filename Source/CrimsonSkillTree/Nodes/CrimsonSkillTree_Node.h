@@ -3,6 +3,9 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "Cost/CrimsonSkillTree_NodeCost.h"
+#include "Cost/CrimsonSkillTree_NodeCostTable.h"
+#include "CrimsonSkillTree_NodeBitset.h"
+#include "CrimsonSkillTree/Conditions/CrimsonSkillTree_CompiledCondition.h"
 #include "CrimsonSkillTree_Node.generated.h"
 
 struct FCrimsonSkillTree_SaveGameNodeState;
@@ -104,6 +107,7 @@ public:
 	virtual bool CanCreateConnection(UCrimsonSkillTree_Node* Other, FText& ErrorMessage);
 	virtual bool CanCreateConnectionTo(UCrimsonSkillTree_Node* Other, int32 NumberOfChildrenNodes, FText& ErrorMessage);
 	virtual bool CanCreateConnectionFrom(UCrimsonSkillTree_Node* Other, int32 NumberOfParentNodes, FText& ErrorMessage);
+	/** @brief Also invalidates the owning template's shared definition, so costs and conditions are rebuilt. */
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 	FText GetContextMenuName() const { return ContextMenuName; }
 	TSubclassOf<UCrimsonSkillTree> GetCompatibleSkillTreeClass() const { return CompatibleSkillTreeClass; }
@@ -124,6 +128,81 @@ public:
 	 */
 	FGuid GetNodeGUID() const { return NodeGuid; }
 
+	/**
+	 * @brief Gets the dense index assigned to this node when its tree instance was created.
+	 * @return The index into the tree's FCrimsonSkillTree_NodeStateBlock, or INDEX_NONE if the tree has not been instanced.
+	 */
+	int32 GetNodeIndex() const { return NodeIndex; }
+
+	/**
+	 * @brief Sets the dense index of this node. Only FCrimsonSkillTree_NodeStateBlock::Build should call this.
+	 * @param InNodeIndex The new dense index.
+	 */
+	void SetNodeIndex(int32 InNodeIndex) { NodeIndex = InNodeIndex; }
+
+	// ~Definition
+	// =============================================================================================================
+	/**
+	 * @brief Initializes a runtime instance node from the template asset's node.
+	 * @details Runtime instance nodes are created with NewObject rather than duplicated. Only what per-actor state
+	 * needs is copied: NodeGuid, MaxLevel, bIsActiveByDefault and NodeTypeTag. Costs, display data, events and
+	 * conditions stay on the template node and are read through GetDefinitionNode. Parent and child links are set
+	 * afterwards by the manager, from the shared definition's adjacency.
+	 * @param InTemplateNode The node of the template asset this node is an instance of.
+	 */
+	void InitializeFromTemplate(const UCrimsonSkillTree_Node* InTemplateNode);
+
+	/**
+	 * @brief Gets the node that holds this node's immutable definition data.
+	 * @return The template asset's node on runtime instances, or this node on template assets.
+	 */
+	const UCrimsonSkillTree_Node* GetDefinitionNode() const { return TemplateNode ? TemplateNode.Get() : this; }
+
+	/** @brief Gets the configured costs, from the template node. */
+	TConstArrayView<FNodeResourceCost> GetNodeCosts() const { return GetDefinitionNode()->NodeCosts; }
+
+	/**
+	 * @brief Gets the configured level-changed events, from the template node.
+	 * @details These objects are shared by every actor. Use them for queries that take the node as a parameter
+	 * (GetTooltipDescription, PopulateSimulationData); execute events through GetOrCreateEventInstance.
+	 */
+	TConstArrayView<TObjectPtr<UCrimsonSkillTree_NodeEventBase>> GetLevelChangedEventDefinitions() const { return GetDefinitionNode()->OnLevelChangedEvents; }
+
+	/**
+	 * @brief Gets the configured activation conditions, from the template node.
+	 * @details These objects are shared by every actor. IsConditionMet and the tooltip functions may be called on them
+	 * directly; monitoring goes through GetOrCreateConditionInstance.
+	 */
+	TConstArrayView<TObjectPtr<UCrimsonSkillTree_ActivationConditionBase>> GetActivationConditionDefinitions() const { return GetDefinitionNode()->ActivationConditions; }
+
+	/**
+	 * @brief Gets this actor's instance of a level-changed event, creating it on first use.
+	 * @details Events keep per-actor handles (the active effect, the granted ability), so executing one needs a
+	 * per-actor copy. It is only created once the node first executes the event, so unassigned nodes carry none.
+	 * @param EventIndex The index into GetLevelChangedEventDefinitions.
+	 * @return The per-actor event, or nullptr if the index is invalid.
+	 */
+	UCrimsonSkillTree_NodeEventBase* GetOrCreateEventInstance(int32 EventIndex);
+
+	/**
+	 * @brief Gets this actor's instance of an activation condition, creating it on first use.
+	 * @details Only needed for monitoring, which binds delegates and caches the owning node per actor. Created the
+	 * first time the node starts monitoring its conditions.
+	 * @param ConditionIndex The index into GetActivationConditionDefinitions.
+	 * @return The per-actor condition, or nullptr if the index is invalid.
+	 */
+	UCrimsonSkillTree_ActivationConditionBase* GetOrCreateConditionInstance(int32 ConditionIndex);
+
+	/**
+	 * @brief Drops the per-actor event and condition instances. Called from ShutdownNode, after monitoring has ended
+	 * and the events have run their reset.
+	 */
+	void ReleaseDefinitionInstances()
+	{
+		EventInstances.Reset();
+		ConditionInstances.Reset();
+	}
+
 	// ~Node Relationships & Structure
 	// =============================================================================================================
 	/**
@@ -193,6 +272,8 @@ public:
 	virtual bool CanIncrementLevel();
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node|State Checks")
 	virtual bool CanDecrementLevel();
+	/** @brief Checks every cost of TargetLevel against the manager's cached budgets. Used by CanActivate, CanIncrementLevel and UI highlighting. */
+	bool CanAffordTargetLevel(int32 TargetLevel) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node|State Checks")
 	bool IsMaxLevel() const { return MaxLevel > 0 && CurrentLevel >= MaxLevel; }
 
@@ -211,37 +292,133 @@ public:
 
 	// ~Prerequisite & Condition Logic
 	// =============================================================================================================
+	/**
+	 * @brief Checks the node's ActivationConditions.
+	 * @details Runs the compiled condition program from the shared definition. Only if it fails are the conditions
+	 * evaluated again through their UFUNCTIONs, so that they can broadcast their failure messages.
+	 */
 	bool ArePrerequisitesMet() const;
+
+	/**
+	 * @brief Gets the compiled ActivationConditions of this node from the tree's shared definition.
+	 * @return The program, or nullptr if the node has no dense index yet.
+	 */
+	const FCrimsonSkillTree_CompiledCondition* GetCompiledConditions() const;
 	bool IsReachableFromRoot(const TSet<const UCrimsonSkillTree_Node*>& IgnoredNodes) const;
+
+	/**
+	 * @brief Collects the nodes that would lose their connection to the root if this node were deactivated.
+	 * @details Answered from the tree's reachability index (dominator subtree of this node) instead of a graph walk per dependent.
+	 * @param OutOrphanedNodes Receives the affected nodes. Empty if none would be orphaned.
+	 */
+	void GetNodesOrphanedIfDeactivated(TArray<UCrimsonSkillTree_Node*>& OutOrphanedNodes) const;
 	bool ArePrerequisitesMetWithHypotheticalChange(AActor* OwnerContext, const TSet<const UCrimsonSkillTree_Node*>& HypotheticallyInactiveNodes, const TSet<const UCrimsonSkillTree_Node*>& HypotheticallyAlteredNodes = {}) const;
+
+	/**
+	 * @brief Bitset variant of IsReachableFromRoot. Bits are dense node indices of this node's tree.
+	 * @param IgnoredNodes Nodes treated as inactive for the walk.
+	 * @return True if a path of active, non-ignored nodes connects this node to the root.
+	 */
+	bool IsReachableFromRoot(const FCrimsonSkillTree_NodeBitset& IgnoredNodes) const;
+
+	/**
+	 * @brief Bitset variant of ArePrerequisitesMetWithHypotheticalChange. Bits are dense node indices of this node's tree.
+	 * @details Does not allocate for trees that fit in the bitset's inline storage. The TSet overload converts its
+	 * arguments and forwards here.
+	 * @param OwnerContext The actor who owns the skill tree.
+	 * @param HypotheticallyInactiveNodes Nodes treated as deactivated.
+	 * @param HypotheticallyAlteredNodes Nodes whose benefits are treated as altered (lost).
+	 * @return True if this node's prerequisites would still be met.
+	 */
+	bool ArePrerequisitesMetWithHypotheticalChange(AActor* OwnerContext, const FCrimsonSkillTree_NodeBitset& HypotheticallyInactiveNodes, const FCrimsonSkillTree_NodeBitset& HypotheticallyAlteredNodes) const;
 	UFUNCTION(BlueprintCallable, Category = "Node|State")
 	bool UpdateNodeOverallState();
 
+	/**
+	 * @brief Defers UpdateNodeOverallState to the owning tree's dirty queue.
+	 * @details Used by parent state changes and condition callbacks instead of calling UpdateNodeOverallState
+	 * directly, so a cascade evaluates each node at most once per batch.
+	 */
+	void MarkOverallStateDirty();
+
 	// ~UI & Display
 	// =============================================================================================================
 	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "Node|Display")
 	FText GetDescription() const;
+	/** @brief Builds the UI data from the template node's display data and this node's state. */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node|Display")
-	virtual FCrimsonSkillTree_Node_UIData GetUIData() const { return NodeUIData; };
+	virtual FCrimsonSkillTree_Node_UIData GetUIData() const;
 	UFUNCTION(BlueprintCallable, Category = "Node|Display", meta = (DisplayName = "Get Tooltip Descriptions"))
 	void GetTooltipUIDescriptions(TArray<FText>& OutConditionDescriptions, TArray<FText>& OutEventDescriptions) const;
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Node|Cost")
 	TArray<FText> GetFormattedNodeCosts() const;
 	void BroadcastActivationFailureMessage(const FText& InMessage);
-	UFUNCTION()
-	virtual void InitNodeUIData();
 
 	// ~Save & Load
 	// =============================================================================================================
 	void ApplyLoadedState(const FCrimsonSkillTree_SaveGameNodeState& SaveState);
 	void SetNodeGUID(const FGuid& NewGUID) { NodeGuid = NewGUID; }
+	/**
+	 * @brief Sets the node to a saved level and state, running its level-changed events.
+	 * @details Inside a manager bulk-apply transaction, broadcasts, replication updates, monitoring changes and saves
+	 * are deferred to the end of the transaction.
+	 */
 	void RestoreNodeToState(int32 TargetLevel, ENodeState TargetENodeState, bool bForceEventExecutionFromLevelZero = true);
 
+	/**
+	 * @brief Fires this node's events once for a coalesced transition from OriginalLevel to the current level.
+	 * @details Called by the manager when a bulk-apply transaction ends.
+	 * @param OriginalLevel The level the events were last executed for.
+	 * @param bIsReset True to fire OnNodeReset(OriginalLevel) instead of OnLevelDown.
+	 */
+	void ExecuteCoalescedLevelTransition(int32 OriginalLevel, bool bIsReset);
+
+	// ~Runtime State Block
+	// =============================================================================================================
+	/**
+	 * @brief Single write path for CurrentLevel and NodeState.
+	 * @details Updates the UPROPERTY mirrors and the owning tree's FCrimsonSkillTree_NodeStateBlock so that whole-tree
+	 * passes can read contiguous state instead of visiting each node object. Notifies the tree's reachability index when
+	 * the node crosses between level 0 and level > 0.
+	 * @param NewLevel The node's new level.
+	 * @param NewState The node's new state.
+	 */
+	void SetNodeLevelAndState(int32 NewLevel, ENodeState NewState);
+
 	// ~Cost Calculation
 	// =============================================================================================================
+	/**
+	 * @brief Gets the resolved cost tables of this node from the tree's shared definition.
+	 * @return One table per entry of NodeCosts, or an empty view if the node has no dense index yet.
+	 */
+	TConstArrayView<FNodeCostTable> GetCostTables() const;
+
+	/**
+	 * @brief Gets the cost of reaching a level from the level below it.
+	 * @details Reads the precomputed cost tables; no curve evaluation happens here.
+	 */
 	TArray<FResolvedNodeCost> GetCostsForTargetLevel(int32 TargetLevel) const;
+
+	/**
+	 * @brief Allocation-free variant of GetCostsForTargetLevel that appends into a caller-owned array.
+	 * @param TargetLevel The level being purchased.
+	 * @param OutCosts Receives one entry per resource. Not reset; callers reuse it across nodes.
+	 */
+	void AppendCostsForTargetLevel(int32 TargetLevel, TArray<FResolvedNodeCost>& OutCosts) const;
+
+	/**
+	 * @brief Sums the cost of every level from 1 to CurrentLevel, per resource, from the cost tables' prefix sums.
+	 */
 	TArray<FResolvedNodeCost> GetTotalCostsForAllActiveLevels() const;
 
+	/**
+	 * @brief Gets the cost of moving between two levels, per resource, in O(1) per resource.
+	 * @param FromLevel The starting level.
+	 * @param ToLevel The final level. May be below FromLevel for refunds.
+	 * @param OutCosts Receives one entry per resource. Not reset.
+	 */
+	void AppendCostsForLevelRange(int32 FromLevel, int32 ToLevel, TArray<FResolvedNodeCost>& OutCosts) const;
+
 	// ~Graph Editor Data
 	// =============================================================================================================
 	void AddChildNode(UCrimsonSkillTree_Node* ChildNode);
@@ -285,10 +462,13 @@ public:
 	int32 MaxLevel;
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Node|Config")
 	bool bIsActiveByDefault = false;
+	/** @brief Authoring data. Only populated on template nodes; runtime instances read it through GetNodeCosts. */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Node|Cost")
 	TArray<FNodeResourceCost> NodeCosts;
+	/** @brief Authoring data. Only populated on template nodes; see GetLevelChangedEventDefinitions. */
 	UPROPERTY(EditAnywhere, Instanced, BlueprintReadWrite, Category = "Node|Events", meta = (DisplayName = "On Level Changed Events"))
 	TArray<TObjectPtr<UCrimsonSkillTree_NodeEventBase>> OnLevelChangedEvents;
+	/** @brief Authoring data. Only populated on template nodes; see GetActivationConditionDefinitions. */
 	UPROPERTY(EditAnywhere, Instanced, BlueprintReadWrite, Category = "Node|Conditions", meta = (DisplayName = "Activation Conditions"))
 	TArray<TObjectPtr<UCrimsonSkillTree_ActivationConditionBase>> ActivationConditions;
 
@@ -329,8 +509,21 @@ private:
 	TArray<TObjectPtr<UCrimsonSkillTree_Node>> ChildrenNodes;
 	UPROPERTY()
 	TMap<TObjectPtr<UCrimsonSkillTree_Node>, TObjectPtr<UCrimsonSkillTree_Edge>> Edges;
-	UPROPERTY()
-	FCrimsonSkillTree_Node_UIData NodeUIData;
+
+	/** @brief Dense index into the owning tree's state block. Assigned at instancing time, never serialized. */
+	int32 NodeIndex = INDEX_NONE;
+
+	/** @brief The template asset's node this runtime node was initialized from. Null on template nodes. */
+	UPROPERTY(Transient)
+	TObjectPtr<const UCrimsonSkillTree_Node> TemplateNode;
+
+	/** @brief Per-actor event instances by index into the template's OnLevelChangedEvents. Created on first execution. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCrimsonSkillTree_NodeEventBase>> EventInstances;
+
+	/** @brief Per-actor condition instances by index into the template's ActivationConditions. Created when monitoring starts. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UCrimsonSkillTree_ActivationConditionBase>> ConditionInstances;
 
 #if WITH_EDITORONLY_DATA
 	UPROPERTY()
@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @struct FCrimsonSkillTree_NodeBitset
+ * @brief Fixed-width set of dense node indices, stored as 64-bit words.
+ * @details Used by the hypothetical-change API in place of TSet<const UCrimsonSkillTree_Node*>. Membership tests are a
+ * shift and a mask, set operations work a word at a time, and trees of up to 1024 nodes fit in the inline storage,
+ * so building and querying a hypothetical set does not touch the heap.
+ */
+struct FCrimsonSkillTree_NodeBitset
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	static constexpr int32 BitsPerWord = 64;
+
+	FCrimsonSkillTree_NodeBitset() = default;
+	explicit FCrimsonSkillTree_NodeBitset(int32 InNumBits) { Init(InNumBits); }
+
+	/**
+	 * @brief Resizes the set to hold InNumBits indices and clears every bit. Keeps the existing allocation.
+	 * @param InNumBits The number of nodes in the tree.
+	 */
+	void Init(int32 InNumBits)
+	{
+		NumBits = FMath::Max(0, InNumBits);
+		Words.SetNumZeroed(FMath::DivideAndRoundUp(NumBits, BitsPerWord), EAllowShrinking::No);
+		FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64));
+	}
+
+	/**
+	 * @brief Clears every bit without changing the size.
+	 */
+	void ClearAll() { FMemory::Memzero(Words.GetData(), Words.Num() * sizeof(uint64)); }
+
+	int32 Num() const { return NumBits; }
+
+	void Add(int32 Index)
+	{
+		if (Index >= 0 && Index < NumBits)
+		{
+			Words[Index / BitsPerWord] |= (uint64(1) << (Index % BitsPerWord));
+		}
+	}
+
+	void Remove(int32 Index)
+	{
+		if (Index >= 0 && Index < NumBits)
+		{
+			Words[Index / BitsPerWord] &= ~(uint64(1) << (Index % BitsPerWord));
+		}
+	}
+
+	bool Contains(int32 Index) const
+	{
+		return Index >= 0 && Index < NumBits && (Words[Index / BitsPerWord] & (uint64(1) << (Index % BitsPerWord))) != 0;
+	}
+
+	bool IsEmpty() const
+	{
+		for (const uint64 Word : Words)
+		{
+			if (Word != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * @brief Checks whether this set and another share at least one index.
+	 * @param Other A set of the same width.
+	 * @return True if the sets intersect.
+	 */
+	bool Intersects(const FCrimsonSkillTree_NodeBitset& Other) const
+	{
+		const int32 NumWords = FMath::Min(Words.Num(), Other.Words.Num());
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			if ((Words[WordIndex] & Other.Words[WordIndex]) != 0)
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/** @brief In-place union (word-wide OR). */
+	FCrimsonSkillTree_NodeBitset& operator|=(const FCrimsonSkillTree_NodeBitset& Other)
+	{
+		const int32 NumWords = FMath::Min(Words.Num(), Other.Words.Num());
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			Words[WordIndex] |= Other.Words[WordIndex];
+		}
+		return *this;
+	}
+
+	/** @brief In-place intersection (word-wide AND). */
+	FCrimsonSkillTree_NodeBitset& operator&=(const FCrimsonSkillTree_NodeBitset& Other)
+	{
+		const int32 NumWords = FMath::Min(Words.Num(), Other.Words.Num());
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			Words[WordIndex] &= Other.Words[WordIndex];
+		}
+		for (int32 WordIndex = NumWords; WordIndex < Words.Num(); ++WordIndex)
+		{
+			Words[WordIndex] = 0;
+		}
+		return *this;
+	}
+
+	/** @brief In-place difference (word-wide AND NOT). */
+	void RemoveAll(const FCrimsonSkillTree_NodeBitset& Other)
+	{
+		const int32 NumWords = FMath::Min(Words.Num(), Other.Words.Num());
+		for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+		{
+			Words[WordIndex] &= ~Other.Words[WordIndex];
+		}
+	}
+
+	/**
+	 * @brief Calls a function for every index in the set, in ascending order.
+	 * @param Func Callable taking an int32 index.
+	 */
+	template <typename FuncType>
+	void ForEachSetBit(FuncType&& Func) const
+	{
+		for (int32 WordIndex = 0; WordIndex < Words.Num(); ++WordIndex)
+		{
+			uint64 Word = Words[WordIndex];
+			while (Word != 0)
+			{
+				const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Word));
+				Func(WordIndex * BitsPerWord + Bit);
+				Word &= Word - 1;
+			}
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief Bit storage. 16 inline words cover trees of up to 1024 nodes without a heap allocation. */
+	TArray<uint64, TInlineAllocator<16>> Words;
+
+	/** @brief Number of valid bits. */
+	int32 NumBits = 0;
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_Node.h"
+#include "CrimsonSkillTree_SharedDefinition.h"
+
+/**
+ * @struct FCrimsonSkillTree_NodeStateBlock
+ * @brief Struct-of-arrays per-player runtime state for every node of a single skill tree instance.
+ * @details Each node receives a dense index (0..NumNodes-1) when the tree is instanced. Levels and states are stored in
+ * contiguous arrays indexed by that value, so whole-tree passes stream through linear memory instead of chasing
+ * UObject pointers. Parent/child adjacency (CSR) lives in the FCrimsonSkillTree_SharedDefinition of the template
+ * asset and is shared by every instance; this block only owns what differs per player.
+ * UCrimsonSkillTree_Node keeps its CurrentLevel/NodeState properties for Blueprint and save compatibility and mirrors
+ * every change into this block through SetNodeLevelAndState.
+ */
+struct FCrimsonSkillTree_NodeStateBlock
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+
+	// ~Construction
+	// =============================================================================================================
+	/**
+	 * @brief Assigns dense indices to the given nodes and builds the level/state arrays.
+	 * @details Instance nodes are mapped to the shared definition's indices by GUID. Nodes the definition does not
+	 * know about (which only happens if the instance was modified after it was created) are left with INDEX_NONE.
+	 * @param InNodes The flat list of nodes of a runtime tree instance (UCrimsonSkillTree::AllNodes).
+	 * @param InDefinition The shared definition of the template asset this instance was created from.
+	 */
+	void Build(const TArray<TObjectPtr<UCrimsonSkillTree_Node>>& InNodes, const TSharedPtr<const FCrimsonSkillTree_SharedDefinition>& InDefinition)
+	{
+		Reset();
+		if (!InDefinition.IsValid())
+		{
+			return;
+		}
+
+		Definition = InDefinition;
+		const int32 NumNodes = Definition->Num();
+		Nodes.SetNumZeroed(NumNodes);
+		Levels.SetNumZeroed(NumNodes);
+		States.Init(ENodeState::UnSet, NumNodes);
+
+		for (UCrimsonSkillTree_Node* Node : InNodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+
+			const int32 Index = Definition->FindIndexByGuid(Node->NodeGuid);
+			Node->SetNodeIndex(Index);
+			if (Index != INDEX_NONE)
+			{
+				Nodes[Index] = Node;
+				Levels[Index] = Node->CurrentLevel;
+				States[Index] = Node->NodeState;
+			}
+		}
+	}
+
+	/**
+	 * @brief Releases all state and the reference to the shared definition.
+	 */
+	void Reset()
+	{
+		Definition.Reset();
+		Nodes.Reset();
+		Levels.Reset();
+		States.Reset();
+	}
+
+	// ~Accessors
+	// =============================================================================================================
+	int32 Num() const { return Levels.Num(); }
+	bool IsValidIndex(int32 NodeIndex) const { return Levels.IsValidIndex(NodeIndex); }
+	UCrimsonSkillTree_Node* GetNode(int32 NodeIndex) const { return Nodes.IsValidIndex(NodeIndex) ? Nodes[NodeIndex] : nullptr; }
+	const FCrimsonSkillTree_SharedDefinition* GetDefinition() const { return Definition.Get(); }
+
+	int32 GetLevel(int32 NodeIndex) const { return Levels[NodeIndex]; }
+	ENodeState GetState(int32 NodeIndex) const { return States[NodeIndex]; }
+	bool IsActive(int32 NodeIndex) const { return Levels[NodeIndex] > 0; }
+
+	TConstArrayView<int32> GetLevels() const { return Levels; }
+	TConstArrayView<ENodeState> GetStates() const { return States; }
+
+	/**
+	 * @brief Gets the dense indices of the parents of a node from the shared definition.
+	 * @param NodeIndex The dense index of the node.
+	 * @return A view into the shared CSR parent index array. Empty before Build or if the tree has no definition.
+	 */
+	TConstArrayView<int32> GetParents(int32 NodeIndex) const { return Definition.IsValid() ? Definition->GetParents(NodeIndex) : TConstArrayView<int32>(); }
+
+	/**
+	 * @brief Gets the dense indices of the children of a node from the shared definition.
+	 * @param NodeIndex The dense index of the node.
+	 * @return A view into the shared CSR child index array. Empty before Build or if the tree has no definition.
+	 */
+	TConstArrayView<int32> GetChildren(int32 NodeIndex) const { return Definition.IsValid() ? Definition->GetChildren(NodeIndex) : TConstArrayView<int32>(); }
+
+	// ~Mutation
+	// =============================================================================================================
+	/**
+	 * @brief Writes the level and state of a node into the block.
+	 * @param NodeIndex The dense index of the node.
+	 * @param NewLevel The node's new level.
+	 * @param NewState The node's new state.
+	 */
+	void SetLevelAndState(int32 NodeIndex, int32 NewLevel, ENodeState NewState)
+	{
+		if (IsValidIndex(NodeIndex))
+		{
+			Levels[NodeIndex] = NewLevel;
+			States[NodeIndex] = NewState;
+		}
+	}
+
+	/**
+	 * @brief Copies every level and state of the block, e.g. before a batch that may need to be rolled back.
+	 * @param OutLevels Receives the levels.
+	 * @param OutStates Receives the states.
+	 */
+	void CopyStatesTo(TArray<int32>& OutLevels, TArray<ENodeState>& OutStates) const
+	{
+		OutLevels = Levels;
+		OutStates = States;
+	}
+
+	/**
+	 * @brief Resets every level and state in one linear pass.
+	 * @details Does not notify the tree's reachability index; call UCrimsonSkillTree::ResetNodeStates instead.
+	 */
+	void ResetAllStates()
+	{
+		FMemory::Memzero(Levels.GetData(), Levels.Num() * sizeof(int32));
+		for (ENodeState& State : States)
+		{
+			State = ENodeState::UnSet;
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief Shared, immutable topology of the template asset. */
+	TSharedPtr<const FCrimsonSkillTree_SharedDefinition> Definition;
+
+	/** @brief Dense index -> node object. Only used to map back from index space; never iterated on hot paths. */
+	TArray<UCrimsonSkillTree_Node*> Nodes;
+
+	/** @brief Current level per dense node index. */
+	TArray<int32> Levels;
+
+	/** @brief Current state per dense node index. */
+	TArray<ENodeState> States;
+};
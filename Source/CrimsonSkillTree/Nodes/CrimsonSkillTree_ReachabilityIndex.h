@@ -0,0 +1,392 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_NodeStateBlock.h"
+
+/**
+ * @struct FCrimsonSkillTree_ReachabilityIndex
+ * @brief Maintained reachability structure over the active nodes of a skill tree instance.
+ * @details Keeps two pieces of data, both in dense node index space:
+ * - Per-node active parent counts, updated incrementally in O(degree) whenever a node becomes active or inactive.
+ *   This answers "does this node still have an active parent" in O(1).
+ * - A dominator tree over the subgraph of active nodes reachable from the root. A node D dominates N when every
+ *   path from the root to N passes through D. So the nodes that become orphaned when X is deactivated are
+ *   exactly X's dominator subtree, and can be collected in time proportional to that subtree. The tree is
+ *   updated lazily on the first query after activation changes, instead of running a BFS per candidate.
+ * Only nodes downstream of a node whose activation changed can have a different dominator, since every other node
+ * reaches the root without passing through it. The update renumbers the post-order and the CSR children lists in one
+ * linear pass over the active nodes, and runs the Cooper-Harvey-Kennedy fixpoint iteration over the affected nodes
+ * only, seeded with the unchanged dominators of the rest. A dominator is an ancestor of its nodes in every DFS tree, so
+ * the old dominators stay valid under the new post-order numbers. All working buffers are members and are reused.
+ * The dominator tree is a cache: queries are const and update it through mutable members.
+ */
+struct FCrimsonSkillTree_ReachabilityIndex
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+
+	// ~Construction
+	// =============================================================================================================
+	/**
+	 * @brief Initializes the index from the current state of a tree instance.
+	 * @param InStateBlock The state block of the tree instance. Must outlive this index.
+	 */
+	void Build(const FCrimsonSkillTree_NodeStateBlock& InStateBlock)
+	{
+		StateBlock = &InStateBlock;
+		const FCrimsonSkillTree_SharedDefinition* Definition = StateBlock->GetDefinition();
+		RootIndex = Definition ? Definition->GetRootIndex() : INDEX_NONE;
+
+		const int32 NumNodes = StateBlock->Num();
+		ActiveParentCounts.SetNumZeroed(NumNodes);
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			if (IsNodeActive(Index))
+			{
+				for (const int32 ChildIndex : StateBlock->GetChildren(Index))
+				{
+					++ActiveParentCounts[ChildIndex];
+				}
+			}
+		}
+		ChangedIndices.Reset();
+		bDominatorsDirty = true;
+	}
+
+	/**
+	 * @brief Releases all data.
+	 */
+	void Reset()
+	{
+		StateBlock = nullptr;
+		RootIndex = INDEX_NONE;
+		ActiveParentCounts.Reset();
+		ImmediateDominators.Reset();
+		PostOrderNumbers.Reset();
+		DominatorChildOffsets.Reset();
+		DominatorChildIndices.Reset();
+		ChangedIndices.Reset();
+		PostOrderScratch.Empty();
+		DfsStackScratch.Empty();
+		AffectedScratch.Empty();
+		NodeFlagsScratch.Empty();
+		bDominatorsDirty = true;
+	}
+
+	// ~Maintenance
+	// =============================================================================================================
+	/**
+	 * @brief Must be called whenever a node crosses between level 0 and level > 0.
+	 * @details The root is always counted as active (see IsNodeActive), so its own transitions are ignored. Calls must
+	 * pair up per node; an unpaired deactivation trips the check instead of being clamped away.
+	 * @param NodeIndex The dense index of the node.
+	 * @param bIsNowActive True if the node became active, false if it became inactive.
+	 */
+	void OnNodeActivationChanged(int32 NodeIndex, bool bIsNowActive)
+	{
+		if (!StateBlock || !StateBlock->IsValidIndex(NodeIndex) || NodeIndex == RootIndex)
+		{
+			return;
+		}
+
+		const int32 Delta = bIsNowActive ? 1 : -1;
+		for (const int32 ChildIndex : StateBlock->GetChildren(NodeIndex))
+		{
+			ActiveParentCounts[ChildIndex] += Delta;
+			check(ActiveParentCounts[ChildIndex] >= 0);
+		}
+		if (!bDominatorsDirty)
+		{
+			ChangedIndices.AddUnique(NodeIndex);
+		}
+	}
+
+	/**
+	 * @brief Must be called after every level and state of the observed block was reset at once, e.g. by
+	 * FCrimsonSkillTree_NodeStateBlock::ResetAllStates, which bypasses OnNodeActivationChanged.
+	 * @details Recounts the active parents from the block and schedules a full dominator rebuild.
+	 */
+	void OnAllStatesReset()
+	{
+		if (StateBlock)
+		{
+			Build(*StateBlock);
+		}
+	}
+
+	// ~Queries
+	// =============================================================================================================
+	/**
+	 * @brief Gets the number of active parents of a node.
+	 * @param NodeIndex The dense index of the node.
+	 * @return The active parent count.
+	 */
+	int32 GetActiveParentCount(int32 NodeIndex) const { return ActiveParentCounts.IsValidIndex(NodeIndex) ? ActiveParentCounts[NodeIndex] : 0; }
+
+	/**
+	 * @brief Checks whether a node is reachable from the root through active nodes.
+	 * @param NodeIndex The dense index of the node.
+	 * @return True if the node is the root or connected to it through active nodes.
+	 */
+	bool IsReachableFromRoot(int32 NodeIndex) const
+	{
+		UpdateDominators();
+		return PostOrderNumbers.IsValidIndex(NodeIndex) && PostOrderNumbers[NodeIndex] != INDEX_NONE;
+	}
+
+	/**
+	 * @brief Collects every active node that would lose its connection to the root if a node were deactivated.
+	 * @param NodeIndex The dense index of the node being deactivated.
+	 * @param OutOrphanedIndices Receives the dense indices of the nodes in NodeIndex's dominator subtree, excluding NodeIndex itself.
+	 */
+	void CollectOrphanedIfDeactivated(int32 NodeIndex, TArray<int32>& OutOrphanedIndices) const
+	{
+		OutOrphanedIndices.Reset();
+		UpdateDominators();
+		if (!PostOrderNumbers.IsValidIndex(NodeIndex) || PostOrderNumbers[NodeIndex] == INDEX_NONE)
+		{
+			return;
+		}
+
+		TArray<int32, TInlineAllocator<32>> Stack;
+		Stack.Add(NodeIndex);
+		while (Stack.Num() > 0)
+		{
+			const int32 Current = Stack.Pop(EAllowShrinking::No);
+			for (int32 Offset = DominatorChildOffsets[Current]; Offset < DominatorChildOffsets[Current + 1]; ++Offset)
+			{
+				const int32 Dominated = DominatorChildIndices[Offset];
+				OutOrphanedIndices.Add(Dominated);
+				Stack.Add(Dominated);
+			}
+		}
+	}
+
+	/**
+	 * @brief Checks whether deactivating a node would orphan any other active node.
+	 * @param NodeIndex The dense index of the node being deactivated.
+	 * @return True if at least one node is dominated by NodeIndex.
+	 */
+	bool WouldOrphanAny(int32 NodeIndex) const
+	{
+		UpdateDominators();
+		return DominatorChildOffsets.IsValidIndex(NodeIndex + 1) && DominatorChildOffsets[NodeIndex + 1] > DominatorChildOffsets[NodeIndex];
+	}
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	bool IsNodeActive(int32 NodeIndex) const
+	{
+		return NodeIndex == RootIndex || StateBlock->IsActive(NodeIndex);
+	}
+
+	/**
+	 * @brief Brings the dominator tree up to date with the activation changes made since the last update.
+	 * @details Rebuilds every dominator after Build, and otherwise only those of the nodes downstream of ChangedIndices.
+	 */
+	void UpdateDominators() const
+	{
+		if (!StateBlock || (!bDominatorsDirty && ChangedIndices.Num() == 0))
+		{
+			return;
+		}
+
+		const int32 NumNodes = StateBlock->Num();
+		const bool bFullRebuild = bDominatorsDirty || ImmediateDominators.Num() != NumNodes;
+		bDominatorsDirty = false;
+
+		NodeFlagsScratch.Init(0, NumNodes);
+		if (bFullRebuild)
+		{
+			ImmediateDominators.Init(INDEX_NONE, NumNodes);
+		}
+		else
+		{
+			CollectAffectedNodes();
+		}
+		ChangedIndices.Reset();
+
+		PostOrderNumbers.Init(INDEX_NONE, NumNodes);
+		DominatorChildOffsets.Init(0, NumNodes + 1);
+		DominatorChildIndices.Reset();
+		PostOrderScratch.Reset();
+		if (!StateBlock->IsValidIndex(RootIndex))
+		{
+			ImmediateDominators.Init(INDEX_NONE, NumNodes);
+			return;
+		}
+
+		// Iterative DFS over active nodes to produce a post-order.
+		DfsStackScratch.Reset();
+		DfsStackScratch.Emplace(RootIndex, 0);
+		NodeFlagsScratch[RootIndex] |= VisitedFlag;
+		while (DfsStackScratch.Num() > 0)
+		{
+			TPair<int32, int32>& Top = DfsStackScratch.Last();
+			const TConstArrayView<int32> Children = StateBlock->GetChildren(Top.Key);
+			if (Top.Value < Children.Num())
+			{
+				const int32 ChildIndex = Children[Top.Value++];
+				if (!(NodeFlagsScratch[ChildIndex] & VisitedFlag) && IsNodeActive(ChildIndex))
+				{
+					NodeFlagsScratch[ChildIndex] |= VisitedFlag;
+					DfsStackScratch.Emplace(ChildIndex, 0);
+				}
+			}
+			else
+			{
+				PostOrderNumbers[Top.Key] = PostOrderScratch.Num();
+				PostOrderScratch.Add(Top.Key);
+				DfsStackScratch.Pop(EAllowShrinking::No);
+			}
+		}
+
+		// Nodes that are no longer reachable lose their dominator; affected ones are recomputed from scratch below.
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			if (PostOrderNumbers[Index] == INDEX_NONE || (NodeFlagsScratch[Index] & AffectedFlag))
+			{
+				ImmediateDominators[Index] = INDEX_NONE;
+			}
+		}
+
+		auto Intersect = [this](int32 A, int32 B)
+		{
+			while (A != B)
+			{
+				while (PostOrderNumbers[A] < PostOrderNumbers[B]) { A = ImmediateDominators[A]; }
+				while (PostOrderNumbers[B] < PostOrderNumbers[A]) { B = ImmediateDominators[B]; }
+			}
+			return A;
+		};
+
+		// Cooper-Harvey-Kennedy: iterate in reverse post-order until the immediate dominators are stable. Unaffected
+		// nodes keep their dominators and are skipped.
+		ImmediateDominators[RootIndex] = RootIndex;
+		bool bChanged = true;
+		while (bChanged)
+		{
+			bChanged = false;
+			for (int32 Order = PostOrderScratch.Num() - 2; Order >= 0; --Order)
+			{
+				const int32 NodeIndex = PostOrderScratch[Order];
+				if (!bFullRebuild && !(NodeFlagsScratch[NodeIndex] & AffectedFlag))
+				{
+					continue;
+				}
+
+				int32 NewDominator = INDEX_NONE;
+				for (const int32 ParentIndex : StateBlock->GetParents(NodeIndex))
+				{
+					if (PostOrderNumbers[ParentIndex] == INDEX_NONE || ImmediateDominators[ParentIndex] == INDEX_NONE)
+					{
+						continue;
+					}
+					NewDominator = NewDominator == INDEX_NONE ? ParentIndex : Intersect(ParentIndex, NewDominator);
+				}
+				if (NewDominator != INDEX_NONE && ImmediateDominators[NodeIndex] != NewDominator)
+				{
+					ImmediateDominators[NodeIndex] = NewDominator;
+					bChanged = true;
+				}
+			}
+		}
+
+		// Flatten the dominator tree into CSR children lists. AffectedScratch is reused as the write cursor.
+		for (const int32 NodeIndex : PostOrderScratch)
+		{
+			if (NodeIndex != RootIndex)
+			{
+				++DominatorChildOffsets[ImmediateDominators[NodeIndex] + 1];
+			}
+		}
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			DominatorChildOffsets[Index + 1] += DominatorChildOffsets[Index];
+		}
+		DominatorChildIndices.SetNumUninitialized(DominatorChildOffsets[NumNodes]);
+		AffectedScratch.Reset();
+		AffectedScratch.Append(DominatorChildOffsets.GetData(), NumNodes);
+		for (const int32 NodeIndex : PostOrderScratch)
+		{
+			if (NodeIndex != RootIndex)
+			{
+				DominatorChildIndices[AffectedScratch[ImmediateDominators[NodeIndex]]++] = NodeIndex;
+			}
+		}
+	}
+
+	/**
+	 * @brief Flags every node reachable from ChangedIndices through active nodes with AffectedFlag.
+	 * @details Paths that pass through an inactive node other than the changed one are unreachable before and after
+	 * the change, so they are not followed.
+	 */
+	void CollectAffectedNodes() const
+	{
+		AffectedScratch.Reset();
+		for (const int32 ChangedIndex : ChangedIndices)
+		{
+			if (!(NodeFlagsScratch[ChangedIndex] & AffectedFlag))
+			{
+				NodeFlagsScratch[ChangedIndex] |= AffectedFlag;
+				AffectedScratch.Add(ChangedIndex);
+			}
+		}
+		while (AffectedScratch.Num() > 0)
+		{
+			const int32 Current = AffectedScratch.Pop(EAllowShrinking::No);
+			for (const int32 ChildIndex : StateBlock->GetChildren(Current))
+			{
+				if (!(NodeFlagsScratch[ChildIndex] & AffectedFlag) && IsNodeActive(ChildIndex))
+				{
+					NodeFlagsScratch[ChildIndex] |= AffectedFlag;
+					AffectedScratch.Add(ChildIndex);
+				}
+			}
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief The state block this index observes. */
+	const FCrimsonSkillTree_NodeStateBlock* StateBlock = nullptr;
+
+	/** @brief Dense index of the root node. The root counts as active regardless of its level. */
+	int32 RootIndex = INDEX_NONE;
+
+	/** @brief Number of active parents per dense node index. */
+	TArray<int32> ActiveParentCounts;
+
+	/** @brief Immediate dominator per dense node index, INDEX_NONE for unreachable nodes. */
+	mutable TArray<int32> ImmediateDominators;
+
+	/** @brief Post-order number per dense node index, INDEX_NONE for unreachable nodes. */
+	mutable TArray<int32> PostOrderNumbers;
+
+	/** @brief CSR row offsets of the dominator tree (Num + 1 entries). */
+	mutable TArray<int32> DominatorChildOffsets;
+
+	/** @brief CSR column data of the dominator tree. */
+	mutable TArray<int32> DominatorChildIndices;
+
+	/** @brief Nodes whose activation changed since the last update. Unused while a full rebuild is pending. */
+	mutable TArray<int32> ChangedIndices;
+
+	/** @brief Set by Build when every dominator must be recomputed. */
+	mutable bool bDominatorsDirty = true;
+
+	// Working buffers of UpdateDominators, kept between updates so they do not allocate.
+	static constexpr uint8 VisitedFlag = 1 << 0;
+	static constexpr uint8 AffectedFlag = 1 << 1;
+
+	mutable TArray<int32> PostOrderScratch;
+	mutable TArray<TPair<int32, int32>> DfsStackScratch; // (Node, next child offset within its child list)
+	mutable TArray<int32> AffectedScratch;
+	mutable TArray<uint8> NodeFlagsScratch;
+};
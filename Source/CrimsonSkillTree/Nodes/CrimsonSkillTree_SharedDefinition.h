@@ -0,0 +1,398 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CrimsonSkillTree_Node.h"
+#include "Cost/CrimsonSkillTree_NodeCostTable.h"
+
+/**
+ * @struct FCrimsonSkillTree_SharedDefinition
+ * @brief Immutable, per-asset description of a skill tree's static data.
+ * @details Built once from the template asset and shared read-only (via TSharedPtr<const ...>) by every runtime
+ * instance created from it, so topology and per-node static data are stored once per asset instead of once per actor.
+ * Per-node costs are resolved into FNodeCostTable entries here, so no curve is evaluated after the asset is loaded.
+ * Activation conditions are compiled once per node here as well. Display data, events and the condition objects are
+ * reached through the template node of each index; runtime instance nodes only hold per-actor state.
+ * Dense node indices are the positions of the nodes in the template's AllNodes array; runtime instances map their
+ * nodes onto the same indices through FindIndexByGuid.
+ * The template nodes and the fallback conditions of the compiled programs are referenced without a UPROPERTY. Every
+ * tree holding the definition reports them from UCrimsonSkillTree::AddReferencedObjects, so they stay alive for as
+ * long as the definition does, even after an edit has replaced the template's nodes.
+ */
+struct FCrimsonSkillTree_SharedDefinition
+{
+public:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+
+	// ~Construction
+	// =============================================================================================================
+	/**
+	 * @brief Builds the definition from the nodes of a template asset. The nodes are not modified.
+	 * @param InTemplateNodes The flat node list of the template asset (UCrimsonSkillTree::AllNodes).
+	 * @param TemplateRootNode The root node of the template asset, may be nullptr.
+	 */
+	void Build(const TArray<TObjectPtr<UCrimsonSkillTree_Node>>& InTemplateNodes, const UCrimsonSkillTree_Node* TemplateRootNode)
+	{
+		const int32 NumNodes = InTemplateNodes.Num();
+
+		TMap<const UCrimsonSkillTree_Node*, int32> IndexByNode;
+		IndexByNode.Reserve(NumNodes);
+		TemplateNodes.Reset(NumNodes);
+		NodeGuids.Reset(NumNodes);
+		MaxLevels.Reset(NumNodes);
+		GuidToIndex.Reset();
+		GuidToIndex.Reserve(NumNodes);
+		CostTableOffsets.SetNumUninitialized(NumNodes + 1);
+		CostTables.Reset();
+		ResourceIds.Reset();
+		CostEntryNodeIndices.Reset();
+		CostEntryResourceSlots.Reset();
+		CostEntryPrefixOffsets.Reset();
+		CumulativeCostPool.Reset();
+		RootIndex = INDEX_NONE;
+
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			const UCrimsonSkillTree_Node* Node = InTemplateNodes[Index];
+			IndexByNode.Add(Node, Index);
+			TemplateNodes.Add(Node);
+			NodeGuids.Add(Node ? Node->NodeGuid : FGuid());
+			MaxLevels.Add(Node ? Node->MaxLevel : 0);
+			if (Node)
+			{
+				GuidToIndex.Add(Node->NodeGuid, Index);
+			}
+			if (Node && Node == TemplateRootNode)
+			{
+				RootIndex = Index;
+			}
+
+			CostTableOffsets[Index] = CostTables.Num();
+			if (Node)
+			{
+				for (const FNodeResourceCost& ResourceCost : Node->NodeCosts)
+				{
+					FNodeCostTable& CostTable = CostTables.AddDefaulted_GetRef();
+					CostTable.Build(ResourceCost, Node->MaxLevel);
+					if (CostTable.CostDefinition.CostSource == ENodeCostSource::NoCost)
+					{
+						continue;
+					}
+
+					CostEntryNodeIndices.Add(Index);
+					CostEntryResourceSlots.Add(ResourceIds.AddUnique(CostTable.ResourceId));
+					CostEntryPrefixOffsets.Add(CumulativeCostPool.Num());
+					CumulativeCostPool.Append(CostTable.CumulativeCosts);
+				}
+			}
+		}
+		CostTableOffsets[NumNodes] = CostTables.Num();
+
+		auto BuildAdjacency = [&](TArray<int32>& OutOffsets, TArray<int32>& OutIndices, bool bParents)
+		{
+			OutOffsets.SetNumUninitialized(NumNodes + 1);
+			OutIndices.Reset();
+			for (int32 Index = 0; Index < NumNodes; ++Index)
+			{
+				OutOffsets[Index] = OutIndices.Num();
+				const UCrimsonSkillTree_Node* Node = InTemplateNodes[Index];
+				if (!Node)
+				{
+					continue;
+				}
+
+				const TArray<UCrimsonSkillTree_Node*>& Links = bParents ? Node->GetParentNodesArray() : Node->GetChildrenNodesArray();
+				for (const UCrimsonSkillTree_Node* Linked : Links)
+				{
+					if (const int32* LinkedIndex = IndexByNode.Find(Linked))
+					{
+						OutIndices.Add(*LinkedIndex);
+					}
+				}
+			}
+			OutOffsets[NumNodes] = OutIndices.Num();
+		};
+
+		BuildAdjacency(ParentOffsets, ParentIndices, true);
+		BuildAdjacency(ChildOffsets, ChildIndices, false);
+		BuildTopologicalRanks();
+
+		// Index addressing is only valid while both sides agree on the GUID at every dense index.
+		DefinitionHash = GetTypeHash(NumNodes);
+		for (const FGuid& NodeGuid : NodeGuids)
+		{
+			DefinitionHash = HashCombine(DefinitionHash, GetTypeHash(NodeGuid));
+		}
+
+		// Conditions are compiled last: their parent references resolve through GuidToIndex.
+		CompiledConditions.SetNum(NumNodes);
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			CompiledConditions[Index].Reset();
+			if (const UCrimsonSkillTree_Node* Node = TemplateNodes[Index])
+			{
+				CompiledConditions[Index].Compile(Node->ActivationConditions, [this](const FGuid& InNodeGuid) { return FindIndexByGuid(InNodeGuid); });
+			}
+		}
+	}
+
+	// ~Accessors
+	// =============================================================================================================
+	int32 Num() const { return NodeGuids.Num(); }
+	bool IsValidIndex(int32 NodeIndex) const { return NodeGuids.IsValidIndex(NodeIndex); }
+	int32 GetRootIndex() const { return RootIndex; }
+
+	/**
+	 * @brief Gets a hash of the node count and of the node GUID at every dense index.
+	 * @details Two definitions with the same hash map dense indices to the same nodes, so replicated node states can be
+	 * addressed by index between them.
+	 */
+	uint32 GetDefinitionHash() const { return DefinitionHash; }
+
+	/**
+	 * @brief Reports the template nodes and the fallback conditions of every compiled program to the garbage collector.
+	 * @param Collector The reference collector of the current GC pass.
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector) const
+	{
+		for (const UCrimsonSkillTree_Node* Node : TemplateNodes)
+		{
+			Collector.AddReferencedObject(Node);
+		}
+		for (const FCrimsonSkillTree_CompiledCondition& Program : CompiledConditions)
+		{
+			Program.AddReferencedObjects(Collector);
+		}
+	}
+	const FGuid& GetNodeGuid(int32 NodeIndex) const { return NodeGuids[NodeIndex]; }
+	int32 GetMaxLevel(int32 NodeIndex) const { return MaxLevels[NodeIndex]; }
+
+	/**
+	 * @brief Gets the template asset's node at a dense index. Holds the node's costs, display data, events and conditions.
+	 * @param NodeIndex The dense index of the node.
+	 * @return The template node, or nullptr if the index is invalid.
+	 */
+	const UCrimsonSkillTree_Node* GetTemplateNode(int32 NodeIndex) const { return TemplateNodes.IsValidIndex(NodeIndex) ? TemplateNodes[NodeIndex] : nullptr; }
+
+	/**
+	 * @brief Gets the compiled activation conditions of a node, shared by every actor.
+	 * @param NodeIndex The dense index of the node.
+	 * @return The compiled program, or nullptr if the index is invalid.
+	 */
+	const FCrimsonSkillTree_CompiledCondition* GetCompiledConditions(int32 NodeIndex) const { return CompiledConditions.IsValidIndex(NodeIndex) ? &CompiledConditions[NodeIndex] : nullptr; }
+
+	/**
+	 * @brief Gets the position of a node in a topological order of the tree (parents before children).
+	 * @param NodeIndex The dense index of the node.
+	 * @return The rank. Every parent has a lower rank than its children.
+	 */
+	int32 GetTopologicalRank(int32 NodeIndex) const { return TopologicalRanks[NodeIndex]; }
+
+	/**
+	 * @brief Finds the dense index of a node by its GUID.
+	 * @param InNodeGuid The GUID of the node.
+	 * @return The dense index, or INDEX_NONE if this definition does not contain the node.
+	 */
+	int32 FindIndexByGuid(const FGuid& InNodeGuid) const
+	{
+		const int32* FoundIndex = GuidToIndex.Find(InNodeGuid);
+		return FoundIndex ? *FoundIndex : INDEX_NONE;
+	}
+
+	/**
+	 * @brief Gets the dense indices of the parents of a node.
+	 * @param NodeIndex The dense index of the node.
+	 * @return A view into the CSR parent index array.
+	 */
+	TConstArrayView<int32> GetParents(int32 NodeIndex) const
+	{
+		return TConstArrayView<int32>(ParentIndices.GetData() + ParentOffsets[NodeIndex], ParentOffsets[NodeIndex + 1] - ParentOffsets[NodeIndex]);
+	}
+
+	/**
+	 * @brief Gets the dense indices of the children of a node.
+	 * @param NodeIndex The dense index of the node.
+	 * @return A view into the CSR child index array.
+	 */
+	TConstArrayView<int32> GetChildren(int32 NodeIndex) const
+	{
+		return TConstArrayView<int32>(ChildIndices.GetData() + ChildOffsets[NodeIndex], ChildOffsets[NodeIndex + 1] - ChildOffsets[NodeIndex]);
+	}
+
+	/**
+	 * @brief Gets the resolved cost tables of a node, one per entry of its NodeCosts.
+	 * @param NodeIndex The dense index of the node.
+	 * @return A view into the shared cost table array.
+	 */
+	TConstArrayView<FNodeCostTable> GetCostTables(int32 NodeIndex) const
+	{
+		return TConstArrayView<FNodeCostTable>(CostTables.GetData() + CostTableOffsets[NodeIndex], CostTableOffsets[NodeIndex + 1] - CostTableOffsets[NodeIndex]);
+	}
+
+	/**
+	 * @brief Gets the distinct resources priced anywhere in this tree. Positions are the slots used by AccumulateSpentPerResource.
+	 * @return The ResourceIds (FCrimsonSkillTree_ResourceRegistry), in first-use order.
+	 */
+	TConstArrayView<int32> GetResourceIds() const { return ResourceIds; }
+
+	/**
+	 * @brief Computes the total amount spent per resource for a whole tree instance in one linear pass.
+	 * @details Walks the flat cost-entry stream (node index, resource slot, prefix offset) built alongside the cost
+	 * tables and adds one prefix-sum read per entry. No per-node arrays are created, and the loop body has no
+	 * branches, so the compiler can keep it in registers.
+	 * @param Levels The current level per dense node index (FCrimsonSkillTree_NodeStateBlock::GetLevels).
+	 * @param OutTotals Receives the total per resource slot. Must have GetResourceIds().Num() entries; added to, not reset.
+	 */
+	void AccumulateSpentPerResource(TConstArrayView<int32> Levels, TArrayView<int32> OutTotals) const
+	{
+		check(Levels.Num() >= Num() && OutTotals.Num() >= ResourceIds.Num());
+		const int32 NumEntries = CostEntryNodeIndices.Num();
+		const int32* RESTRICT NodeIndices = CostEntryNodeIndices.GetData();
+		const int32* RESTRICT ResourceSlots = CostEntryResourceSlots.GetData();
+		const int32* RESTRICT PrefixOffsets = CostEntryPrefixOffsets.GetData();
+		const int32* RESTRICT Pool = CumulativeCostPool.GetData();
+		for (int32 Entry = 0; Entry < NumEntries; ++Entry)
+		{
+			const int32 NodeIndex = NodeIndices[Entry];
+			const int32 Level = FMath::Clamp(Levels[NodeIndex], 0, MaxLevels[NodeIndex]);
+			OutTotals[ResourceSlots[Entry]] += Pool[PrefixOffsets[Entry] + Level];
+		}
+	}
+
+	/**
+	 * @brief Gets the approximate heap footprint of this definition, for memory reports.
+	 * @return The allocated size in bytes.
+	 */
+	SIZE_T GetAllocatedSize() const
+	{
+		SIZE_T Size = TemplateNodes.GetAllocatedSize() + NodeGuids.GetAllocatedSize() + MaxLevels.GetAllocatedSize() + GuidToIndex.GetAllocatedSize()
+			+ ParentOffsets.GetAllocatedSize() + ParentIndices.GetAllocatedSize()
+			+ ChildOffsets.GetAllocatedSize() + ChildIndices.GetAllocatedSize();
+		Size += TopologicalRanks.GetAllocatedSize();
+		Size += CostTableOffsets.GetAllocatedSize() + CostTables.GetAllocatedSize() + ResourceIds.GetAllocatedSize()
+			+ CostEntryNodeIndices.GetAllocatedSize() + CostEntryResourceSlots.GetAllocatedSize()
+			+ CostEntryPrefixOffsets.GetAllocatedSize() + CumulativeCostPool.GetAllocatedSize();
+		for (const FNodeCostTable& CostTable : CostTables)
+		{
+			Size += CostTable.GetAllocatedSize();
+		}
+		Size += CompiledConditions.GetAllocatedSize();
+		for (const FCrimsonSkillTree_CompiledCondition& Program : CompiledConditions)
+		{
+			Size += Program.GetAllocatedSize();
+		}
+		return Size;
+	}
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	/**
+	 * @brief Assigns TopologicalRanks with Kahn's algorithm over the child adjacency.
+	 * @details Skill trees are authored as DAGs. If a cycle slipped through, the nodes on it are ranked after every
+	 * other node in index order, so the ranks stay a valid permutation.
+	 */
+	void BuildTopologicalRanks()
+	{
+		const int32 NumNodes = Num();
+		TopologicalRanks.Init(INDEX_NONE, NumNodes);
+
+		TArray<int32> PendingParents;
+		PendingParents.SetNumUninitialized(NumNodes);
+		TArray<int32> Ready;
+		Ready.Reserve(NumNodes);
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			PendingParents[Index] = ParentOffsets[Index + 1] - ParentOffsets[Index];
+			if (PendingParents[Index] == 0)
+			{
+				Ready.Add(Index);
+			}
+		}
+
+		int32 NextRank = 0;
+		for (int32 Cursor = 0; Cursor < Ready.Num(); ++Cursor)
+		{
+			const int32 Index = Ready[Cursor];
+			TopologicalRanks[Index] = NextRank++;
+			for (const int32 ChildIndex : GetChildren(Index))
+			{
+				if (--PendingParents[ChildIndex] == 0)
+				{
+					Ready.Add(ChildIndex);
+				}
+			}
+		}
+
+		for (int32 Index = 0; Index < NumNodes; ++Index)
+		{
+			if (TopologicalRanks[Index] == INDEX_NONE)
+			{
+				TopologicalRanks[Index] = NextRank++;
+			}
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Properties                                                           *
+	****************************************************************************************************************/
+	/** @brief Template asset node per dense index. Reported by AddReferencedObjects, see the struct comment. */
+	TArray<const UCrimsonSkillTree_Node*> TemplateNodes;
+
+	/** @brief Node GUID per dense index. */
+	TArray<FGuid> NodeGuids;
+
+	/** @brief Configured max level per dense index. */
+	TArray<int32> MaxLevels;
+
+	/** @brief GUID -> dense index. */
+	TMap<FGuid, int32> GuidToIndex;
+
+	/** @brief Dense index of the template's root node, or INDEX_NONE. */
+	int32 RootIndex = INDEX_NONE;
+
+	/** @brief See GetDefinitionHash. */
+	uint32 DefinitionHash = 0;
+
+	/** @brief CSR row offsets into ParentIndices (Num + 1 entries). */
+	TArray<int32> ParentOffsets;
+
+	/** @brief CSR column data: dense parent indices. */
+	TArray<int32> ParentIndices;
+
+	/** @brief CSR row offsets into ChildIndices (Num + 1 entries). */
+	TArray<int32> ChildOffsets;
+
+	/** @brief CSR column data: dense child indices. */
+	TArray<int32> ChildIndices;
+
+	/** @brief Topological rank per dense index. Parents rank lower than their children. */
+	TArray<int32> TopologicalRanks;
+
+	/** @brief Row offsets into CostTables (Num + 1 entries). */
+	TArray<int32> CostTableOffsets;
+
+	/** @brief Resolved cost tables of every node, grouped by dense index in NodeCosts order. */
+	TArray<FNodeCostTable> CostTables;
+
+	/** @brief ResourceIds of the distinct resources priced in this tree. Index is the resource slot of the cost-entry stream. */
+	TArray<int32> ResourceIds;
+
+	/** @brief Cost-entry stream: dense node index per entry. */
+	TArray<int32> CostEntryNodeIndices;
+
+	/** @brief Cost-entry stream: resource slot per entry. */
+	TArray<int32> CostEntryResourceSlots;
+
+	/** @brief Cost-entry stream: offset of the entry's prefix sums in CumulativeCostPool. */
+	TArray<int32> CostEntryPrefixOffsets;
+
+	/** @brief Every cost table's CumulativeCosts, concatenated so the whole-tree pass reads a single array. */
+	TArray<int32> CumulativeCostPool;
+
+	/** @brief Compiled ActivationConditions per dense index. */
+	TArray<FCrimsonSkillTree_CompiledCondition> CompiledConditions;
+};
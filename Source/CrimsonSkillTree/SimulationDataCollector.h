@@ -3,15 +3,15 @@
 #include "CoreMinimal.h"
 #include "UObject/ObjectMacros.h"
 #include "UObject/Class.h"
-#include "Misc/ScopeRWLock.h"
-#include "UObject/StructOnScope.h"
 #include "SimulationDataCollector.generated.h"
 
 /**
  * @struct FSimulationDataCollector
  * @brief Collects various types of simulation data (as USTRUCTs) from NodeEvents.
  * @details ActivationConditions can query this collector for data types they understand.
- * The data is stored in a map where the key is the UStruct type and the value is an array of instances.
+ * Instances are stored per UScriptStruct in fixed-size chunks of contiguous, typed memory. Chunks never move, so
+ * returned pointers stay valid until Clear, and Clear destroys the instances but keeps the chunks. A collector reused
+ * across previews therefore stops allocating once it has seen the largest preview.
  */
 USTRUCT(BlueprintType)
 struct FSimulationDataCollector
@@ -24,9 +24,46 @@ public:
 	****************************************************************************************************************/
 	FSimulationDataCollector() = default;
 
+	FSimulationDataCollector(const FSimulationDataCollector& Other)
+	{
+		CopyFrom(Other);
+	}
+
+	FSimulationDataCollector(FSimulationDataCollector&& Other)
+		: Buckets(MoveTemp(Other.Buckets))
+	{
+		Other.Buckets.Reset();
+	}
+
+	FSimulationDataCollector& operator=(const FSimulationDataCollector& Other)
+	{
+		if (this != &Other)
+		{
+			Clear();
+			CopyFrom(Other);
+		}
+		return *this;
+	}
+
+	FSimulationDataCollector& operator=(FSimulationDataCollector&& Other)
+	{
+		if (this != &Other)
+		{
+			ReleaseAll();
+			Buckets = MoveTemp(Other.Buckets);
+			Other.Buckets.Reset();
+		}
+		return *this;
+	}
+
+	~FSimulationDataCollector()
+	{
+		ReleaseAll();
+	}
+
 	/**
 	 * @brief Adds a piece of simulation data (any USTRUCT) to the collector.
-	 * @details The data is copied into a new FStructOnScope for proper memory management.
+	 * @details The data is copied into the next free slot of the type's chunk storage.
 	 * @tparam FStructType The type of the USTRUCT to add.
 	 * @param DataPayload The actual data to add.
 	 */
@@ -36,17 +73,13 @@ public:
 		const UScriptStruct* StructType = FStructType::StaticStruct();
 		if (!StructType) return;
 
-		TSharedPtr<FStructOnScope> NewDataInstance = MakeShared<FStructOnScope>(StructType);
-		StructType->CopyScriptStruct(NewDataInstance->GetStructMemory(), &DataPayload);
-
-		TArray<TSharedPtr<FStructOnScope>>& DataList = CollectedData.FindOrAdd(StructType);
-		DataList.Add(NewDataInstance);
+		AddRaw(FindOrAddBucket(StructType), &DataPayload);
 	}
 
 	/**
 	 * @brief Retrieves the first piece of simulation data of the specified USTRUCT type.
 	 * @tparam FStructType The type of the USTRUCT to retrieve.
-	 * @return A const pointer to the data if found, otherwise nullptr. The pointer is valid for the lifetime of the collector.
+	 * @return A const pointer to the data if found, otherwise nullptr. The pointer is valid until the collector is cleared.
 	 */
 	template <typename FStructType>
 	const FStructType* GetData() const
@@ -54,10 +87,10 @@ public:
 		const UScriptStruct* StructType = FStructType::StaticStruct();
 		if (!StructType) return nullptr;
 
-		const TArray<TSharedPtr<FStructOnScope>>* DataListPtr = CollectedData.Find(StructType);
-		if (DataListPtr && DataListPtr->Num() > 0 && (*DataListPtr)[0].IsValid())
+		const FTypeBucket* Bucket = FindBucket(StructType);
+		if (Bucket && Bucket->Num > 0)
 		{
-			return reinterpret_cast<const FStructType*>((*DataListPtr)[0]->GetStructMemory());
+			return reinterpret_cast<const FStructType*>(Bucket->GetElement(0));
 		}
 		return nullptr;
 	}
@@ -65,41 +98,141 @@ public:
 	/**
 	 * @brief Retrieves all pieces of simulation data of a specified USTRUCT type.
 	 * @tparam FStructType The type of the USTRUCT to retrieve.
-	 * @param OutDataArray An array that will be populated with const pointers to the data. Pointers are valid for the lifetime of the collector.
+	 * @param OutDataArray An array that will be populated with const pointers to the data. Pointers are valid until the collector is cleared.
 	 */
 	template <typename FStructType>
 	void GetAllDataOfType(TArray<const FStructType*>& OutDataArray) const
 	{
-		OutDataArray.Empty();
+		OutDataArray.Reset();
 		const UScriptStruct* StructType = FStructType::StaticStruct();
 		if (!StructType) return;
 
-		const TArray<TSharedPtr<FStructOnScope>>* DataListPtr = CollectedData.Find(StructType);
-		if (DataListPtr)
+		if (const FTypeBucket* Bucket = FindBucket(StructType))
 		{
-			for (const TSharedPtr<FStructOnScope>& DataInstance : *DataListPtr)
+			OutDataArray.Reserve(Bucket->Num);
+			for (int32 Index = 0; Index < Bucket->Num; ++Index)
 			{
-				if (DataInstance.IsValid())
-				{
-					OutDataArray.Add(reinterpret_cast<const FStructType*>(DataInstance->GetStructMemory()));
-				}
+				OutDataArray.Add(reinterpret_cast<const FStructType*>(Bucket->GetElement(Index)));
 			}
 		}
 	}
 
 	/**
 	 * @brief Clears all data currently stored in the collector.
+	 * @details Destroys every stored instance but keeps the chunk memory for reuse.
 	 */
 	void Clear()
 	{
-		CollectedData.Empty();
+		for (FTypeBucket& Bucket : Buckets)
+		{
+			Bucket.DestroyElements();
+		}
+	}
+
+private:
+	/****************************************************************************************************************
+	* Functions                                                            *
+	****************************************************************************************************************/
+	struct FTypeBucket;
+
+	const FTypeBucket* FindBucket(const UScriptStruct* StructType) const
+	{
+		return Buckets.FindByPredicate([StructType](const FTypeBucket& Bucket) { return Bucket.StructType == StructType; });
+	}
+
+	FTypeBucket& FindOrAddBucket(const UScriptStruct* StructType)
+	{
+		if (FTypeBucket* Existing = Buckets.FindByPredicate([StructType](const FTypeBucket& Bucket) { return Bucket.StructType == StructType; }))
+		{
+			return *Existing;
+		}
+
+		FTypeBucket& Bucket = Buckets.AddDefaulted_GetRef();
+		Bucket.StructType = StructType;
+		Bucket.Alignment = FMath::Max(StructType->GetMinAlignment(), 1);
+		Bucket.Stride = Align(FMath::Max(StructType->GetStructureSize(), 1), Bucket.Alignment);
+		return Bucket;
+	}
+
+	/**
+	 * @brief Copy-constructs an instance into the next free slot, allocating a chunk only when all retained chunks are full.
+	 * @param Bucket The bucket of the instance's type.
+	 * @param Source The instance to copy.
+	 */
+	static void AddRaw(FTypeBucket& Bucket, const void* Source)
+	{
+		if (Bucket.Num == Bucket.Chunks.Num() * ElementsPerChunk)
+		{
+			Bucket.Chunks.Add(static_cast<uint8*>(FMemory::Malloc(static_cast<SIZE_T>(Bucket.Stride) * ElementsPerChunk, Bucket.Alignment)));
+		}
+
+		uint8* Destination = Bucket.GetElement(Bucket.Num++);
+		Bucket.StructType->InitializeStruct(Destination);
+		Bucket.StructType->CopyScriptStruct(Destination, Source);
+	}
+
+	void CopyFrom(const FSimulationDataCollector& Other)
+	{
+		for (const FTypeBucket& OtherBucket : Other.Buckets)
+		{
+			FTypeBucket& Bucket = FindOrAddBucket(OtherBucket.StructType);
+			for (int32 Index = 0; Index < OtherBucket.Num; ++Index)
+			{
+				AddRaw(Bucket, OtherBucket.GetElement(Index));
+			}
+		}
+	}
+
+	void ReleaseAll()
+	{
+		for (FTypeBucket& Bucket : Buckets)
+		{
+			Bucket.DestroyElements();
+			for (uint8* Chunk : Bucket.Chunks)
+			{
+				FMemory::Free(Chunk);
+			}
+		}
+		Buckets.Reset();
 	}
 
 private:
 	/****************************************************************************************************************
 	* Properties                                                           *
 	****************************************************************************************************************/
+	/** @brief Number of instances per chunk. */
+	static constexpr int32 ElementsPerChunk = 16;
+
+	/**
+	 * @struct FTypeBucket
+	 * @brief Chunked storage for the instances of one struct type.
+	 */
+	struct FTypeBucket
+	{
+		const UScriptStruct* StructType = nullptr;
+		int32 Stride = 0;
+		int32 Alignment = 0;
+		int32 Num = 0;
+		TArray<uint8*, TInlineAllocator<2>> Chunks;
+
+		uint8* GetElement(int32 Index) const
+		{
+			return Chunks[Index / ElementsPerChunk] + (Index % ElementsPerChunk) * Stride;
+		}
+
+		void DestroyElements()
+		{
+			if (!(StructType->StructFlags & STRUCT_IsPlainOldData))
+			{
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					StructType->DestroyStruct(GetElement(Index));
+				}
+			}
+			Num = 0;
+		}
+	};
 
-	/** @brief Stores UStruct type -> array of instances of that struct (as FStructOnScope for proper UStruct handling). */
-	TMap<const UScriptStruct*, TArray<TSharedPtr<FStructOnScope>>> CollectedData;
+	/** @brief One chunked storage bucket per struct type seen. Searched linearly; a preview only involves a handful of types. */
+	TArray<FTypeBucket, TInlineAllocator<4>> Buckets;
 };
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "CommonUserWidget.h"
 #include "GameplayTagContainer.h"
+#include "Blueprint/UserWidgetPool.h"
 #include "Components/CanvasPanel.h"
 #include "CrimsonSkillTree/CrimsonSkillTree.h"
 #include "CrimsonSkillTreeWidget_Graph.generated.h"
@@ -33,6 +34,10 @@ public:
 	* Functions                                                            *
 	****************************************************************************************************************/
 
+	// ~Construction
+	// =============================================================================================================
+	UCrimsonSkillTreeWidget_Graph(const FObjectInitializer& ObjectInitializer);
+
 	// ~UUserWidget Overrides
 	// =============================================================================================================
 	/**
@@ -40,6 +45,12 @@ public:
 	 */
 	virtual void NativeConstruct() override;
 
+	/**
+	 * @brief Releases the Slate widgets of every pooled node, visual node and line widget along with this widget's own.
+	 * @param bReleaseChildren Whether child widgets should release their Slate resources as well.
+	 */
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+
 	// ~Public Methods
 	// =============================================================================================================
 	/**
@@ -51,10 +62,28 @@ public:
 
 	/**
 	 * @brief Removes all node and line widgets from the graph.
+	 * @details Node and visual node widgets are released to NodeWidgetPool and VisualNodeWidgetPool, and line widgets to
+	 * PooledLineWidgets, instead of being destroyed. The next PopulateGraph, for this tree or another one, re-initializes
+	 * them with new node data rather than constructing new widgets.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree Graph")
 	virtual void ClearGraph();
 
+	/**
+	 * @brief Destroys every pooled widget that is not currently displayed.
+	 * @details Call this when the skill tree menu is closed for good and its widgets should be garbage collected.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Skill Tree Graph")
+	void ResetWidgetPools();
+
+	/**
+	 * @brief Gets a line segment image on NodeCanvasPanel, reusing one released by ClearLines when available.
+	 * @details Used by line drawing policies in place of constructing a new UImage per segment. The returned image is
+	 * visible and already added to the canvas; the caller only sets its brush, color and slot layout.
+	 * @return The line segment image, or nullptr if the graph has no canvas.
+	 */
+	UImage* AcquireLineWidget();
+
 	UFUNCTION(BlueprintCallable, Category = "Skill Tree Graph")
 	virtual void SetGraphVisualValues();
 	/**
@@ -169,6 +198,8 @@ protected:
 	// =============================================================================================================
 	/**
 	 * @brief Creates a node widget instance based on the node data and configured class map.
+	 * @details The instance is taken from NodeWidgetPool, which keeps released widgets per class, and is only
+	 * constructed when the pool has no free widget of that class.
 	 * @param ForNodeData The data object for the node to be created.
 	 * @return The newly created and initialized node widget.
 	 */
@@ -178,6 +209,7 @@ protected:
 
 	/**
 	 * @brief Creates a visual node widget instance from its data.
+	 * @details The instance is taken from VisualNodeWidgetPool when a released widget of the class is available.
 	 * @param ForNodeData The data object for the visual node to be created.
 	 * @return The newly created and initialized visual node widget.
 	 */
@@ -189,6 +221,7 @@ protected:
 	// =============================================================================================================
 	/**
 	 * @brief Removes all line widgets from the canvas.
+	 * @details The images stay on the canvas, collapsed, and are moved to PooledLineWidgets for AcquireLineWidget.
 	 */
 	void ClearLines();
 
@@ -255,6 +288,18 @@ private:
 	UPROPERTY(Transient)
 	TArray<TObjectPtr<UImage>> DrawnLineWidgets;
 
+	/** @brief Per-class pool of node widgets. Retained across ClearGraph so switching trees reuses widgets. */
+	UPROPERTY(Transient)
+	FUserWidgetPool NodeWidgetPool;
+
+	/** @brief Per-class pool of visual node widgets. Retained across ClearGraph. */
+	UPROPERTY(Transient)
+	FUserWidgetPool VisualNodeWidgetPool;
+
+	/** @brief Collapsed line images released by ClearLines, handed out again by AcquireLineWidget. */
+	UPROPERTY(Transient)
+	TArray<TObjectPtr<UImage>> PooledLineWidgets;
+
 	/** @brief Weak pointer to the owning display widget to avoid circular dependencies. */
 	UPROPERTY(Transient)
 	TWeakObjectPtr<UCrimsonSkillTreeWidget_Display> ParentDisplayWidget;
@@ -40,6 +40,15 @@ public:
 	void InitializeNode(UCrimsonSkillTree_Node* InNodeData);
 	virtual void InitializeNode_Implementation(UCrimsonSkillTree_Node* InNodeData);
 
+	/**
+	 * @brief Unbinds the widget from its node data before it is returned to the graph's widget pool.
+	 * @details Removes the OnNodeStateChanged binding, closes any open tooltip and clears SkillNodeData and the
+	 * initialization state, so a later InitializeNode can bind the same widget to a different node.
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Skill Tree Node Widget")
+	void ReleaseNode();
+	virtual void ReleaseNode_Implementation();
+
 	/**
 	 * @brief Gets the underlying skill node data object.
 	 * @return The skill node data.
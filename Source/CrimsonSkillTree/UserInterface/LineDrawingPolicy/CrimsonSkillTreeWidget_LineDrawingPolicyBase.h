@@ -71,6 +71,8 @@ protected:
 
 	/**
 	 * @brief Helper function to create a single straight UImage widget representing a line segment.
+	 * @details When the canvas belongs to a UCrimsonSkillTreeWidget_Graph, the image is taken from the graph's line
+	 * widget pool through AcquireLineWidget; a new UImage is only constructed otherwise.
 	 * @param CanvasPanel The canvas panel to add the line segment to.
 	 * @param SegmentStartPoint The starting point of the line segment in canvas space.
 	 * @param SegmentEndPoint The ending point of the line segment in canvas space.